@@ -21,6 +21,8 @@ HEADERS+=$$PWD/include/*.h
 FORMS += $$PWD/ui/*.ui
 # and add the include dir into the search path for Qt and make
 INCLUDEPATH+=./include
+# the LOD core shared with the command line tools (cli/lodgen-cli.pro and the bench/*.pro tools)
+include($$PWD/core/LODCore.pri)
 # where our exe is going to live (root of project)
 DESTDIR=./
 # add the other files
@@ -79,8 +81,7 @@ unix*:QMAKE_CXXFLAGS_WARN_ON += "-Wno-unused-parameter"
 !win32:QMAKE_CXXFLAGS+= -msse -msse2 -msse3
 macx:QMAKE_CXXFLAGS+= -arch x86_64
 macx:INCLUDEPATH+=/usr/local/include/
-linux-g++:QMAKE_CXXFLAGS +=  -march=native
-linux-g++-64:QMAKE_CXXFLAGS +=  -march=native
+# no -march=native so the build runs on any x86-64, the face kernels pick SSE2, AVX2 or AVX-512 at run time
 # define the _DEBUG flag for the graphics lib
 DEFINES +=NGL_DEBUG
 
@@ -90,7 +91,6 @@ unix:LIBS +=  -L/$(HOME)/NGL/lib -l NGL
 
 # now if we are under unix and not on a Mac (i.e. linux)
 linux-*{
-                linux-*:QMAKE_CXXFLAGS +=  -march=native
                 DEFINES += LINUX
 }
 DEPENDPATH+=include
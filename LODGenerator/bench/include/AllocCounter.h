@@ -0,0 +1,19 @@
+#ifndef ALLOCCOUNTER_H_
+#define ALLOCCOUNTER_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file AllocCounter.h
+/// @brief counts every heap allocation lodgen-bench makes. AllocCounter.cpp replaces the global operator new and
+///   delete, it is kept on its own so nothing else sees through the replacements
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the number of calls to operator new since the program started, from every thread
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long getNumAllocs();
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the bytes asked for by those calls
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long getAllocBytes();
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
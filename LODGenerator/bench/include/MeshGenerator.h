@@ -0,0 +1,127 @@
+#ifndef MESHGENERATOR_H_
+#define MESHGENERATOR_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file MeshGenerator.h
+/// @brief makes synthetic obj meshes of any size for the scaling benchmark and lodgen-meshgen
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include "LODVec3.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the shapes MeshGenerator can make
+//----------------------------------------------------------------------------------------------------------------------
+enum MeshShape
+{
+  SHAPE_SPHERE,  ///< subdivided octahedron pushed out onto the unit sphere, closed
+  SHAPE_TERRAIN, ///< square grid with noisy heights, open along its edges
+  SHAPE_TORUS    ///< a ring, closed with a hole through it
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class MeshGenerator "bench/include/MeshGenerator.h"
+/// @brief generates a manifold triangle mesh of roughly the asked for face count, from a thousand faces up to
+///   tens of millions. The mesh is made and written a row at a time so memory use stays small however big it
+///   is, and the same shape, size and seed always give the same file
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 for measuring how the decimator scales past the bundled models
+//----------------------------------------------------------------------------------------------------------------------
+class MeshGenerator
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief constructor, works out the resolution of the shape
+  /// @param[in] _shape the shape to make
+  /// @param[in] _nFaces the number of faces wanted, the mesh has the nearest count the shape can make
+  /// @param[in] _seed seeds the terrain noise
+  //----------------------------------------------------------------------------------------------------------------------
+  MeshGenerator( MeshShape _shape, unsigned int _nFaces, unsigned int _seed=1 );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of vertices the mesh will have
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumVerts() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of faces the mesh will have
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumFaces() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief write the mesh as an obj with just vertices and faces
+  /// @param[in] _fname the file to write
+  /// @returns true if the file was written
+  //----------------------------------------------------------------------------------------------------------------------
+  bool write( const std::string &_fname ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get a shape from its name
+  /// @param[in] _name sphere, terrain or torus
+  /// @param[out] o_shape the shape
+  /// @returns false if the name isn't a shape
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool shapeFromName( const std::string &_name, MeshShape &o_shape );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief read a face count that may end in k or M, eg. 5000, 250k or 2.5M
+  /// @param[in] _text the count
+  /// @param[out] o_nFaces the number of faces
+  /// @returns false if _text isn't a count or is 0
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool parseFaceCount( const std::string &_text, unsigned int &o_nFaces );
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of vertex rows, rings of the sphere or rows of the grid and torus
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumVertRows() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of face rows, the strips between neighbouring vertex rows
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumFaceRows() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add the vertices of one row
+  /// @param[in] _row the row
+  /// @param[in,out] io_verts the vertices are added to the end
+  //----------------------------------------------------------------------------------------------------------------------
+  void addVertRow( unsigned int _row, std::vector<LODVec3> &io_verts ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add the three vertex ids of each face of one row, wound anticlockwise seen from outside
+  /// @param[in] _row the row
+  /// @param[in,out] io_faceVert the corners are added to the end
+  //----------------------------------------------------------------------------------------------------------------------
+  void addFaceRow( unsigned int _row, std::vector<int> &io_faceVert ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the terrain height at a grid point, a few octaves of seeded waves with some per point jitter
+  /// @param[in] _i the column
+  /// @param[in] _j the row
+  //----------------------------------------------------------------------------------------------------------------------
+  float terrainHeight( unsigned int _i, unsigned int _j ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the shape being made
+  //----------------------------------------------------------------------------------------------------------------------
+  MeshShape m_shape;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the sphere's subdivisions along each edge of the octahedron, or the grid and torus columns
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nu;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the grid and torus rows, unused by the sphere
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nv;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the id of the first vertex of each sphere ring, with the vertex count at the end
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<unsigned int> m_ringStart;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief phases and directions of the terrain waves, from the seed
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<float> m_waves;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the seed, also used for the terrain jitter
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_seed;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
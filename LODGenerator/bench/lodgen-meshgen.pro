@@ -0,0 +1,22 @@
+# This specifies the exe name
+TARGET=lodgen-meshgen
+# location of .o files
+OBJECTS_DIR=obj
+# headless tool, no Qt or GL needed
+CONFIG-=qt
+CONFIG+=console
+# on a mac we don't create a .app bundle file ( for ease of multiplatform use)
+CONFIG-=app_bundle
+SOURCES+=$$PWD/meshgen/main.cpp \
+         $$PWD/src/MeshGenerator.cpp
+INCLUDEPATH+=$$PWD/include
+# build the shared LOD core in, the generator writes through its ObjWriter
+include($$PWD/../core/LODCore.pri)
+# where our exe is going to live (root of project, next to the GUI)
+DESTDIR=$$PWD/../
+unix:LIBS += -pthread
+unix:QMAKE_CXXFLAGS += -pthread
+
+win32: {
+        DEFINES+=_USE_MATH_DEFINES
+}
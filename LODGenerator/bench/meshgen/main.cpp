@@ -0,0 +1,63 @@
+/****************************************************************************
+lodgen-meshgen, writes synthetic sphere, terrain and torus obj meshes of any
+size (a thousand faces up to tens of millions) for testing the decimator on
+meshes far bigger than the bundled models
+****************************************************************************/
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include "MeshGenerator.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+void printUsage()
+{
+  std::cout<<"usage: lodgen-meshgen [options] shape faces file.obj\n"
+           <<"  shape               sphere, terrain or torus\n"
+           <<"  faces               the face count wanted, eg. 5000, 250k or 2.5M. The mesh has the\n"
+           <<"                      nearest count the shape can make\n"
+           <<"  -s, --seed N        seeds the terrain noise (default 1)\n"
+           <<"  -h, --help          show this message\n";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  unsigned int seed = 1;
+  std::string args[3];
+  unsigned int nArgs = 0;
+  for (int i=1; i<argc; ++i)
+  {
+    std::string arg = argv[i];
+    if ((arg == "-s" || arg == "--seed") && i+1 < argc)
+    {
+      seed = strtoul(argv[++i], NULL, 10);
+    }
+    else if (arg == "-h" || arg == "--help" || (!arg.empty() && arg[0] == '-') || nArgs == 3)
+    {
+      printUsage();
+      return 1;
+    }
+    else
+    {
+      args[nArgs++] = arg;
+    }
+  }
+
+  MeshShape shape;
+  unsigned int nFaces;
+  if (nArgs != 3 || !MeshGenerator::shapeFromName(args[0], shape) || !MeshGenerator::parseFaceCount(args[1], nFaces))
+  {
+    printUsage();
+    return 1;
+  }
+
+  MeshGenerator generator(shape, nFaces, seed);
+  if (!generator.write(args[2]))
+  {
+    std::cerr<<args[2]<<": could not be written\n";
+    return 1;
+  }
+  std::cout<<args[2]<<": "<<generator.getNumVerts()<<" vertices "<<generator.getNumFaces()<<" faces\n";
+  return 0;
+}
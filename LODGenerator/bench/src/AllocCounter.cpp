@@ -0,0 +1,52 @@
+#include "AllocCounter.h"
+
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file AllocCounter.cpp
+/// @brief replacement global operator new and delete that count what is allocated
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief number of calls to operator new since the program started
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<unsigned long long> s_nAllocs(0);
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief bytes asked for by those calls
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<unsigned long long> s_allocBytes(0);
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long getNumAllocs()
+{
+  return s_nAllocs.load();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long getAllocBytes()
+{
+  return s_allocBytes.load();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief every heap allocation made by the core is counted here, the array and nothrow versions all come through
+///   this one
+//----------------------------------------------------------------------------------------------------------------------
+void* operator new( std::size_t _size )
+{
+  s_nAllocs.fetch_add(1, std::memory_order_relaxed);
+  s_allocBytes.fetch_add(_size, std::memory_order_relaxed);
+  void *p = std::malloc(_size ? _size : 1);
+  if (!p)
+  {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+void* operator new[]( std::size_t _size ) { return operator new(_size); }
+void operator delete( void *_p ) noexcept { std::free(_p); }
+void operator delete[]( void *_p ) noexcept { std::free(_p); }
+void operator delete( void *_p, std::size_t ) noexcept { std::free(_p); }
+void operator delete[]( void *_p, std::size_t ) noexcept { std::free(_p); }
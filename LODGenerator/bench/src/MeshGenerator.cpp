@@ -0,0 +1,360 @@
+#include "MeshGenerator.h"
+#include "ObjWriter.h"
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file MeshGenerator.cpp
+/// @brief implementation files for MeshGenerator class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief rows are gathered until there are this many vertices or corners then written in one block
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned int s_blockSize = 1 << 20;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief number of wave octaves summed for the terrain
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned int s_nOctaves = 5;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief pi, M_PI isn't always defined
+//----------------------------------------------------------------------------------------------------------------------
+static const double s_pi = 3.14159265358979323846;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief mix a grid point and the seed into a well spread 32 bit value (the murmur3 finaliser)
+//----------------------------------------------------------------------------------------------------------------------
+static unsigned int hashPoint( unsigned int _i, unsigned int _j, unsigned int _seed )
+{
+  unsigned int h = _i*0x9e3779b1u ^ (_j + 0x7f4a7c15u)*0x85ebca6bu ^ _seed*0xc2b2ae35u;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MeshGenerator::MeshGenerator( MeshShape _shape, unsigned int _nFaces, unsigned int _seed ) :
+  m_shape(_shape),
+  m_nu(1),
+  m_nv(1),
+  m_seed(_seed)
+{
+  _nFaces = std::max(_nFaces, 8u);
+  switch (m_shape)
+  {
+    case SHAPE_SPHERE :
+    {
+      // 8 n^2 faces, every ring of latitude r steps from a pole has 4r vertices
+      m_nu = std::max(1u, (unsigned int)std::lround(std::sqrt(_nFaces/8.0)));
+      m_ringStart.resize(2*m_nu+2);
+      m_ringStart[0] = 0;
+      for (unsigned int row=0; row<=2*m_nu; ++row)
+      {
+        unsigned int r = m_nu - (row > m_nu ? row-m_nu : m_nu-row);
+        m_ringStart[row+1] = m_ringStart[row] + (r == 0 ? 1 : 4*r);
+      }
+      break;
+    }
+    case SHAPE_TERRAIN :
+    {
+      // 2 (n-1)^2 faces from an n by n grid of points
+      m_nu = std::max(2u, (unsigned int)std::lround(std::sqrt(_nFaces/2.0)) + 1);
+      m_nv = m_nu;
+      std::mt19937 random(m_seed);
+      m_waves.resize(s_nOctaves*3);
+      for (unsigned int i=0; i<s_nOctaves; ++i)
+      {
+        float angle = float(random()/4294967296.0*2.0*s_pi);
+        m_waves[i*3] = std::cos(angle);
+        m_waves[i*3+1] = std::sin(angle);
+        m_waves[i*3+2] = float(random()/4294967296.0*2.0*s_pi);
+      }
+      break;
+    }
+    case SHAPE_TORUS :
+    {
+      // 2 u v faces, three times as many columns around the ring as around the tube
+      m_nv = std::max(3u, (unsigned int)std::lround(std::sqrt(_nFaces/6.0)));
+      m_nu = std::max(3u, (unsigned int)std::lround(_nFaces/(2.0*m_nv)));
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshGenerator::shapeFromName( const std::string &_name, MeshShape &o_shape )
+{
+  if (_name == "sphere")
+  {
+    o_shape = SHAPE_SPHERE;
+  }
+  else if (_name == "terrain")
+  {
+    o_shape = SHAPE_TERRAIN;
+  }
+  else if (_name == "torus")
+  {
+    o_shape = SHAPE_TORUS;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshGenerator::parseFaceCount( const std::string &_text, unsigned int &o_nFaces )
+{
+  char *end;
+  double count = strtod(_text.c_str(), &end);
+  if (*end == 'k' || *end == 'K')
+  {
+    count *= 1e3;
+    ++end;
+  }
+  else if (*end == 'm' || *end == 'M')
+  {
+    count *= 1e6;
+    ++end;
+  }
+  if (*end != '\0' || !(count >= 1.0) || count > 4e9)
+  {
+    return false;
+  }
+  o_nFaces = (unsigned int)count;
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int MeshGenerator::getNumVerts() const
+{
+  return m_shape == SHAPE_SPHERE ? m_ringStart.back() : m_nu*m_nv;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int MeshGenerator::getNumFaces() const
+{
+  switch (m_shape)
+  {
+    case SHAPE_SPHERE : return 8*m_nu*m_nu;
+    case SHAPE_TERRAIN : return 2*(m_nu-1)*(m_nv-1);
+    case SHAPE_TORUS : return 2*m_nu*m_nv;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int MeshGenerator::getNumVertRows() const
+{
+  return m_shape == SHAPE_SPHERE ? 2*m_nu+1 : m_nv;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int MeshGenerator::getNumFaceRows() const
+{
+  switch (m_shape)
+  {
+    case SHAPE_SPHERE : return 2*m_nu;
+    case SHAPE_TERRAIN : return m_nv-1;
+    case SHAPE_TORUS : return m_nv;
+  }
+  return 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+float MeshGenerator::terrainHeight( unsigned int _i, unsigned int _j ) const
+{
+  double x = 2.0*_i/(m_nu-1) - 1.0;
+  double z = 2.0*_j/(m_nv-1) - 1.0;
+  double height = 0.0;
+  double amplitude = 0.15;
+  double frequency = 1.5;
+  for (unsigned int o=0; o<s_nOctaves; ++o)
+  {
+    const float *wave = &m_waves[o*3];
+    height += amplitude*std::sin(frequency*s_pi*(wave[0]*x + wave[1]*z) + wave[2]);
+    amplitude *= 0.5;
+    frequency *= 2.1;
+  }
+  // a little noise at the scale of the grid itself so no two neighbouring faces are exactly flat
+  double jitter = hashPoint(_i, _j, m_seed)/4294967296.0 - 0.5;
+  return float(height + jitter*0.5/(m_nu-1));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshGenerator::addVertRow( unsigned int _row, std::vector<LODVec3> &io_verts ) const
+{
+  switch (m_shape)
+  {
+    case SHAPE_SPHERE :
+    {
+      // the octahedron's lattice points with |x|+|y|+|z| = n, a ring is the diamond at one height, walked a
+      // quadrant at a time
+      int n = m_nu;
+      int y = n - int(_row);
+      int r = n - std::abs(y);
+      if (r == 0)
+      {
+        io_verts.push_back(LODVec3(0.0f, y < 0 ? -1.0f : 1.0f, 0.0f));
+        break;
+      }
+      for (int p=0; p<4*r; ++p)
+      {
+        int t = p%r;
+        int x = 0;
+        int z = 0;
+        switch (p/r)
+        {
+          case 0 : x = r-t; z = t; break;
+          case 1 : x = -t; z = r-t; break;
+          case 2 : x = t-r; z = -t; break;
+          case 3 : x = t; z = t-r; break;
+        }
+        LODVec3 v = LODVec3(float(x), float(y), float(z));
+        io_verts.push_back(v*(1.0f/v.length()));
+      }
+      break;
+    }
+    case SHAPE_TERRAIN :
+    {
+      for (unsigned int i=0; i<m_nu; ++i)
+      {
+        io_verts.push_back(LODVec3(float(2.0*i/(m_nu-1) - 1.0), terrainHeight(i, _row),
+                                   float(2.0*_row/(m_nv-1) - 1.0)));
+      }
+      break;
+    }
+    case SHAPE_TORUS :
+    {
+      const double ringRadius = 1.0;
+      const double tubeRadius = 0.3;
+      double v = 2.0*s_pi*_row/m_nv;
+      for (unsigned int i=0; i<m_nu; ++i)
+      {
+        double u = 2.0*s_pi*i/m_nu;
+        double distance = ringRadius + tubeRadius*std::cos(v);
+        io_verts.push_back(LODVec3(float(distance*std::cos(u)), float(distance*std::sin(u)),
+                                   float(tubeRadius*std::sin(v))));
+      }
+      break;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MeshGenerator::addFaceRow( unsigned int _row, std::vector<int> &io_faceVert ) const
+{
+  if (m_shape == SHAPE_SPHERE)
+  {
+    // a strip between a ring of r vertices per quadrant and the next one out with r+1. The southern half is
+    // the northern one mirrored so its faces are wound the other way
+    bool south = _row >= m_nu;
+    unsigned int inner = south ? _row+1 : _row;
+    unsigned int outer = south ? _row : _row+1;
+    unsigned int r = m_nu - (inner > m_nu ? inner-m_nu : m_nu-inner);
+    unsigned int rOut = r+1;
+    unsigned int innerStart = m_ringStart[inner];
+    unsigned int outerStart = m_ringStart[outer];
+    for (unsigned int q=0; q<4; ++q)
+    {
+      for (unsigned int t=0; t<=2*r; ++t)
+      {
+        // even t are outer edges with an inner tip, odd ones inner edges with an outer tip. a, b, c runs
+        // clockwise seen from outside the northern half
+        unsigned int s = t/2;
+        unsigned int a, b, c;
+        if (t%2 == 0)
+        {
+          a = outerStart + (q*rOut + s)%(4*rOut);
+          b = outerStart + (q*rOut + s+1)%(4*rOut);
+          c = innerStart + (r == 0 ? 0 : (q*r + s)%(4*r));
+        }
+        else
+        {
+          a = innerStart + (q*r + s)%(4*r);
+          b = outerStart + (q*rOut + s+1)%(4*rOut);
+          c = innerStart + (q*r + s+1)%(4*r);
+        }
+        io_faceVert.push_back(a);
+        io_faceVert.push_back(south ? b : c);
+        io_faceVert.push_back(south ? c : b);
+      }
+    }
+    return;
+  }
+
+  // two triangles per grid square, the torus wraps round in both directions
+  bool wrap = m_shape == SHAPE_TORUS;
+  unsigned int nColumns = wrap ? m_nu : m_nu-1;
+  unsigned int row = _row*m_nu;
+  unsigned int nextRow = ((_row+1)%m_nv)*m_nu;
+  for (unsigned int i=0; i<nColumns; ++i)
+  {
+    unsigned int next = (i+1)%m_nu;
+    unsigned int a = row+i;
+    unsigned int b = row+next;
+    unsigned int c = nextRow+next;
+    unsigned int d = nextRow+i;
+    if (wrap)
+    {
+      unsigned int corners[6] = {a, b, c, a, c, d};
+      io_faceVert.insert(io_faceVert.end(), corners, corners+6);
+    }
+    else
+    {
+      // the terrain is y up, going along x then z is clockwise seen from above
+      unsigned int corners[6] = {a, d, c, a, c, b};
+      io_faceVert.insert(io_faceVert.end(), corners, corners+6);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MeshGenerator::write( const std::string &_fname ) const
+{
+  ObjWriter writer;
+  if (!writer.open(_fname))
+  {
+    return false;
+  }
+  static const char *s_names[] = {"sphere", "terrain", "torus"};
+  std::stringstream header;
+  header<<"# LODGenerator synthetic "<<s_names[m_shape]<<", "<<getNumVerts()<<" vertices "<<getNumFaces()<<" faces";
+  writer.writeLine(header.str());
+
+  std::vector<LODVec3> verts;
+  verts.reserve(s_blockSize);
+  for (unsigned int row=0; row<getNumVertRows(); ++row)
+  {
+    addVertRow(row, verts);
+    if (verts.size() >= s_blockSize || row+1 == getNumVertRows())
+    {
+      writer.writeVec3Block("v ", verts, 3);
+      verts.clear();
+    }
+  }
+
+  // no texture coords or normals, the faces are all vertex ids
+  std::vector<int> faceVert;
+  std::vector<int> none;
+  faceVert.reserve(s_blockSize);
+  for (unsigned int row=0; row<getNumFaceRows(); ++row)
+  {
+    addFaceRow(row, faceVert);
+    if (faceVert.size() >= s_blockSize || row+1 == getNumFaceRows())
+    {
+      none.resize(faceVert.size(), -1);
+      writer.writeFaceBlock(faceVert, none, none);
+      faceVert.clear();
+    }
+  }
+  return writer.close();
+}
@@ -0,0 +1,812 @@
+/****************************************************************************
+lodgen-bench, times each phase of the LOD pipeline (load, collapse costs,
+collapse, extraction and save) over a set of obj files so every performance
+change can be measured against the same baseline. --scaling runs the whole
+pipeline over generated meshes of growing size to show how time and memory grow
+****************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#endif
+
+#include "LODMesh.h"
+#include "ParallelFor.h"
+#include "LODCache.h"
+#include "FaceKernels.h"
+#include "MeshGenerator.h"
+#include "AllocCounter.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the phases timed for every file, in the order they run
+//----------------------------------------------------------------------------------------------------------------------
+enum BenchPhase
+{
+  PHASE_LOAD,     ///< parse the obj and build the adjacency, without the costs
+  PHASE_COSTS,    ///< the first pass working out every vertex's collapse cost
+  PHASE_COLLAPSE, ///< buildProgressiveMesh, the whole collapse loop
+  PHASE_EXTRACT,  ///< replay the record and copy out a LOD
+  PHASE_SAVE,     ///< write the base mesh as an obj
+  NUM_PHASES
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief phase names as they are printed
+//----------------------------------------------------------------------------------------------------------------------
+static const char *s_phaseNames[NUM_PHASES] = {"load", "costs", "collapse", "extract", "save"};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the samples of one phase of one file
+//----------------------------------------------------------------------------------------------------------------------
+struct PhaseResult {
+  std::vector<double> m_ms; ///< the time of each run
+  unsigned int m_nElements; ///< what the time is divided by, faces or vertices depending on the phase
+  unsigned long long m_nAllocs; ///< allocations in the last run
+  unsigned long long m_allocBytes; ///< bytes allocated in the last run
+  bool m_countsAllocs; ///< false if the phase can't be separated from the one around it
+  unsigned long long m_nLoopAllocs; ///< collapse only, allocations inside the collapse loop in the last run
+  bool m_loopMeasured; ///< collapse only, true if the last run reported its progress before the first collapse and
+                       ///< after the last, so m_nLoopAllocs covers the whole loop
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the options passed on the command line
+//----------------------------------------------------------------------------------------------------------------------
+struct BenchOptions {
+  std::vector<std::string> m_files; ///< the obj files to time
+  unsigned int m_nRuns; ///< timed runs of every phase
+  unsigned int m_nWarmups; ///< untimed runs first, so the file is in the page cache
+  unsigned int m_nThreads; ///< worker threads, 0 for all cores
+  LODCostMetric m_metric; ///< the edge collapse cost to decimate with
+  float m_batchTolerance; ///< see LODMesh::setBatchTolerance
+  bool m_lazy; ///< see LODMesh::setLazyCosts
+  float m_weldEpsilon; ///< see LODMesh::setWeldEpsilon
+  bool m_checkAllocs; ///< check the collapse loop of every metric doesn't allocate instead of timing phases
+  float m_lodRatio; ///< the faces of the extracted LOD as a ratio of the base
+  std::string m_saveFile; ///< where the save phase writes, removed afterwards
+  bool m_csv; ///< print comma separated values instead of a table
+  bool m_scaling; ///< run the scaling benchmark over generated meshes instead of timing phases of m_files
+  MeshShape m_shape; ///< the generated shape
+  std::vector<unsigned int> m_sizes; ///< face counts of the generated meshes, smallest first
+  std::vector<unsigned int> m_threadCounts; ///< worker thread counts each size is run with
+  std::string m_scratchDir; ///< where the generated meshes are written
+  bool m_keep; ///< keep the generated meshes instead of removing them
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the result of one run of the whole pipeline on a generated mesh
+//----------------------------------------------------------------------------------------------------------------------
+struct ScalingResult {
+  bool m_ok; ///< false if the run failed, or the process running it died, eg. out of memory
+  unsigned int m_nFaces; ///< faces of the mesh loaded
+  double m_loadMs; ///< load time, with the costs
+  double m_decimateMs; ///< buildProgressiveMesh and the LOD extraction
+  double m_saveMs; ///< writing the LOD
+  double m_peakMB; ///< peak resident memory of the run, negative if it can't be measured
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the models that come with the project, used when no files are given
+//----------------------------------------------------------------------------------------------------------------------
+static const char *s_defaultModels[] = {"models/sphere.obj", "models/helix.obj", "models/chair_chesterfield.obj",
+                                        "models/elephant.obj", "models/Batman.obj"};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief faces of the torus --check-allocs generates when no files are given, enough for around 50 progress
+///   reports
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned int s_allocCheckFaces = 200000;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief one set up of the collapse loop checked by --check-allocs
+//----------------------------------------------------------------------------------------------------------------------
+struct AllocCheck {
+  const char *m_name; ///< as it is printed
+  LODCostMetric m_metric; ///< the edge collapse cost
+  bool m_lazy; ///< lazy melax cost updates
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief every metric and the lazy updates, each one a different path through the collapse loop
+//----------------------------------------------------------------------------------------------------------------------
+static const AllocCheck s_allocChecks[] = {{"melax", COST_MELAX, false}, {"melax --lazy", COST_MELAX, true},
+                                           {"qem", COST_QEM, false}, {"qem-optimal", COST_QEM_OPTIMAL, false}};
+
+//----------------------------------------------------------------------------------------------------------------------
+void printUsage()
+{
+  std::cout<<"usage: lodgen-bench [options] [file.obj ...]\n"
+           <<"  -r, --runs N        timed runs of every phase (default 5)\n"
+           <<"  -w, --warmup N      untimed runs before them (default 1)\n"
+           <<"  -j, --threads N     worker threads (default all cores)\n"
+           <<"  -m, --metric NAME   edge collapse cost, melax (default), qem or qem-optimal\n"
+           <<"  -b, --batch TOL     batch decimation tolerance, see lodgen-cli (default 0)\n"
+           <<"      --lazy          lazy melax cost updates, see lodgen-cli\n"
+           <<"      --weld EPS      weld the vertices as each file is loaded, see lodgen-cli (default off)\n"
+           <<"      --check-allocs  instead of timing phases, count the allocations of the one at a time collapse\n"
+           <<"                      loop from its first collapse to its last, with every metric and with --lazy,\n"
+           <<"                      and fail if there are any or the loop couldn't be measured. with no files\n"
+           <<"                      a torus of 200k faces is generated in the scratch folder\n"
+           <<"  -l, --lod RATIO     faces of the extracted LOD as a ratio of the base (default 0.5)\n"
+           <<"  -o, --output FILE   file the save phase writes, removed afterwards\n"
+           <<"                      (default lodgen-bench.obj)\n"
+           <<"      --csv           print comma separated values, one line per file and phase\n"
+           <<"      --scaling       time load, decimate and save of generated meshes over sizes and thread\n"
+           <<"                      counts, with the peak memory of each run, instead of the phases of files\n"
+           <<"      --shape NAME    generated shape, sphere, terrain (default) or torus\n"
+           <<"      --sizes LIST    comma separated face counts (default 1k,10k,100k,1M), up to eg. 50M\n"
+           <<"      --thread-counts LIST  comma separated worker thread counts (default 1 and all cores)\n"
+           <<"      --scratch DIR   where the generated meshes are written (default .)\n"
+           <<"      --keep          don't remove the generated meshes\n"
+           <<"  -h, --help          show this message\n"
+           <<"the .lodc cache is never used. with no files the models that come with LODGenerator are used,\n"
+           <<"run it from the project folder. load, extract and save are per face, costs and collapse per\n"
+           <<"vertex. costs are timed inside load so their allocations are counted with load's. the scaling\n"
+           <<"runs each go in their own process so their peak memory can be told apart. batches on more than\n"
+           <<"one thread allocate as the worker threads start, so --check-allocs ignores -b. set LODGEN_SIMD to scalar, sse2, avx2 or avx512 to time\n"
+           <<"the face kernels of a narrower instruction set than the cpu has\n";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool parseList(const std::string &_list, bool _faceCounts, std::vector<unsigned int> &o_values)
+{
+  std::stringstream stream(_list);
+  std::string item;
+  o_values.clear();
+  while (std::getline(stream, item, ','))
+  {
+    unsigned int value;
+    char *end = NULL;
+    bool ok = _faceCounts ? MeshGenerator::parseFaceCount(item, value) :
+                            ((value = strtoul(item.c_str(), &end, 10)) > 0 && *end == '\0');
+    if (!ok)
+    {
+      std::cerr<<"invalid list item "<<item<<"\n";
+      return false;
+    }
+    o_values.push_back(value);
+  }
+  return !o_values.empty();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool parseArgs(int _argc, char **_argv, BenchOptions &o_options)
+{
+  o_options.m_nRuns = 5;
+  o_options.m_nWarmups = 1;
+  o_options.m_nThreads = 0;
+  o_options.m_metric = COST_MELAX;
+  o_options.m_batchTolerance = 0.0f;
+  o_options.m_lazy = false;
+  o_options.m_weldEpsilon = -1.0f;
+  o_options.m_checkAllocs = false;
+  o_options.m_lodRatio = 0.5f;
+  o_options.m_saveFile = "lodgen-bench.obj";
+  o_options.m_csv = false;
+  o_options.m_scaling = false;
+  o_options.m_shape = SHAPE_TERRAIN;
+  o_options.m_sizes.clear();
+  o_options.m_threadCounts.clear();
+  o_options.m_scratchDir = ".";
+  o_options.m_keep = false;
+  for (int i=1; i<_argc; ++i)
+  {
+    std::string arg = _argv[i];
+    if (arg == "-h" || arg == "--help")
+    {
+      return false;
+    }
+    else if ((arg == "-r" || arg == "--runs") && i+1 < _argc)
+    {
+      o_options.m_nRuns = std::max(1, atoi(_argv[++i]));
+    }
+    else if ((arg == "-w" || arg == "--warmup") && i+1 < _argc)
+    {
+      o_options.m_nWarmups = std::max(0, atoi(_argv[++i]));
+    }
+    else if ((arg == "-j" || arg == "--threads") && i+1 < _argc)
+    {
+      o_options.m_nThreads = std::max(0, atoi(_argv[++i]));
+    }
+    else if ((arg == "-m" || arg == "--metric") && i+1 < _argc)
+    {
+      std::string metric = _argv[++i];
+      if (metric == "melax")
+      {
+        o_options.m_metric = COST_MELAX;
+      }
+      else if (metric == "qem")
+      {
+        o_options.m_metric = COST_QEM;
+      }
+      else if (metric == "qem-optimal")
+      {
+        o_options.m_metric = COST_QEM_OPTIMAL;
+      }
+      else
+      {
+        std::cerr<<"unknown metric "<<metric<<"\n";
+        return false;
+      }
+    }
+    else if ((arg == "-b" || arg == "--batch") && i+1 < _argc)
+    {
+      o_options.m_batchTolerance = strtof(_argv[++i], NULL);
+    }
+    else if (arg == "--lazy")
+    {
+      o_options.m_lazy = true;
+    }
+    else if (arg == "--weld" && i+1 < _argc)
+    {
+      o_options.m_weldEpsilon = strtof(_argv[++i], NULL);
+    }
+    else if (arg == "--check-allocs")
+    {
+      o_options.m_checkAllocs = true;
+    }
+    else if ((arg == "-l" || arg == "--lod") && i+1 < _argc)
+    {
+      char *end;
+      o_options.m_lodRatio = strtof(_argv[++i], &end);
+      if (*end != '\0' || o_options.m_lodRatio <= 0.0f || o_options.m_lodRatio > 1.0f)
+      {
+        std::cerr<<"invalid LOD ratio "<<_argv[i]<<"\n";
+        return false;
+      }
+    }
+    else if ((arg == "-o" || arg == "--output") && i+1 < _argc)
+    {
+      o_options.m_saveFile = _argv[++i];
+    }
+    else if (arg == "--csv")
+    {
+      o_options.m_csv = true;
+    }
+    else if (arg == "--scaling")
+    {
+      o_options.m_scaling = true;
+    }
+    else if (arg == "--shape" && i+1 < _argc)
+    {
+      if (!MeshGenerator::shapeFromName(_argv[++i], o_options.m_shape))
+      {
+        std::cerr<<"unknown shape "<<_argv[i]<<"\n";
+        return false;
+      }
+    }
+    else if (arg == "--sizes" && i+1 < _argc)
+    {
+      if (!parseList(_argv[++i], true, o_options.m_sizes))
+      {
+        return false;
+      }
+      std::sort(o_options.m_sizes.begin(), o_options.m_sizes.end());
+    }
+    else if (arg == "--thread-counts" && i+1 < _argc)
+    {
+      if (!parseList(_argv[++i], false, o_options.m_threadCounts))
+      {
+        return false;
+      }
+    }
+    else if (arg == "--scratch" && i+1 < _argc)
+    {
+      o_options.m_scratchDir = _argv[++i];
+    }
+    else if (arg == "--keep")
+    {
+      o_options.m_keep = true;
+    }
+    else if (!arg.empty() && arg[0] == '-')
+    {
+      std::cerr<<"unknown option "<<arg<<"\n";
+      return false;
+    }
+    else
+    {
+      o_options.m_files.push_back(arg);
+    }
+  }
+  if (o_options.m_sizes.empty())
+  {
+    const unsigned int sizes[] = {1000, 10000, 100000, 1000000};
+    o_options.m_sizes.assign(sizes, sizes+4);
+  }
+  if (o_options.m_threadCounts.empty())
+  {
+    o_options.m_threadCounts.push_back(1);
+    if (std::thread::hardware_concurrency() > 1)
+    {
+      o_options.m_threadCounts.push_back(std::thread::hardware_concurrency());
+    }
+  }
+  if (o_options.m_files.empty() && !o_options.m_checkAllocs)
+  {
+    o_options.m_files.assign(s_defaultModels, s_defaultModels + sizeof(s_defaultModels)/sizeof(s_defaultModels[0]));
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief times a phase and counts what it allocates
+//----------------------------------------------------------------------------------------------------------------------
+class PhaseTimer
+{
+public:
+  PhaseTimer() :
+    m_start(std::chrono::steady_clock::now()),
+    m_nAllocs(getNumAllocs()),
+    m_allocBytes(getAllocBytes()){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add the time and allocations since construction to a result
+  /// @param[in] _minusMs time to take off, eg. a phase timed inside this one
+  /// @param[in] _record false for a warm up run, only the allocations are kept
+  /// @param[in,out] io_result the phase result
+  //----------------------------------------------------------------------------------------------------------------------
+  void stop( double _minusMs, bool _record, PhaseResult &io_result ) const
+  {
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    io_result.m_nAllocs = getNumAllocs() - m_nAllocs;
+    io_result.m_allocBytes = getAllocBytes() - m_allocBytes;
+    io_result.m_countsAllocs = true;
+    if (_record)
+    {
+      io_result.m_ms.push_back(ms - _minusMs);
+    }
+  }
+
+private:
+  std::chrono::steady_clock::time_point m_start; ///< when the phase started
+  unsigned long long m_nAllocs; ///< the allocation count then
+  unsigned long long m_allocBytes; ///< the allocated bytes then
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief run every phase of one file once
+/// @param[in] _file the obj file
+/// @param[in] _options the options
+/// @param[in] _record false for a warm up run
+/// @param[in,out] io_results one result per phase
+/// @returns false if the file couldn't be loaded
+//----------------------------------------------------------------------------------------------------------------------
+bool runFile(const std::string &_file, const BenchOptions &_options, bool _record, PhaseResult *io_results)
+{
+  PhaseTimer loadTimer;
+  LODMesh mesh(_file, _options.m_weldEpsilon);
+  double costMs = mesh.getCostTime();
+  loadTimer.stop(costMs, _record, io_results[PHASE_LOAD]);
+  if (!mesh.getLoaded() || mesh.getNumFaces() == 0)
+  {
+    return false;
+  }
+  if (_record)
+  {
+    io_results[PHASE_COSTS].m_ms.push_back(costMs);
+  }
+  io_results[PHASE_COSTS].m_countsAllocs = false;
+  io_results[PHASE_LOAD].m_nElements = mesh.getNumFaces();
+  io_results[PHASE_COSTS].m_nElements = mesh.getNumVerts();
+
+  // the first progress report is just before the first collapse and the last as soon as the heap is empty, so the
+  // allocations between them are the loop's own, not the set up or the clearing up around it
+  unsigned int nReports = 0;
+  bool finalReport = false;
+  unsigned long long firstAllocs = 0;
+  unsigned long long lastAllocs = 0;
+  if (_options.m_checkAllocs)
+  {
+    mesh.setProgressCallback([&](unsigned int _nRemoved, unsigned int _nTarget)
+    {
+      lastAllocs = getNumAllocs();
+      if (nReports++ == 0)
+      {
+        firstAllocs = lastAllocs;
+      }
+      finalReport = nReports > 1 && _nRemoved == _nTarget;
+      return true;
+    });
+  }
+  PhaseTimer collapseTimer;
+  mesh.setBatchTolerance(_options.m_batchTolerance);
+  mesh.setLazyCosts(_options.m_lazy);
+  mesh.buildProgressiveMesh(_options.m_metric);
+  collapseTimer.stop(0.0, _record, io_results[PHASE_COLLAPSE]);
+  io_results[PHASE_COLLAPSE].m_nElements = mesh.getNumVerts();
+  io_results[PHASE_COLLAPSE].m_nLoopAllocs = lastAllocs - firstAllocs;
+  io_results[PHASE_COLLAPSE].m_loopMeasured = finalReport;
+
+  PhaseTimer extractTimer;
+  LODMesh *lod = mesh.createLOD((unsigned int)(_options.m_lodRatio*mesh.getNumFaces()), _options.m_metric);
+  extractTimer.stop(0.0, _record, io_results[PHASE_EXTRACT]);
+  io_results[PHASE_EXTRACT].m_nElements = lod->getNumFaces();
+  delete lod;
+
+  PhaseTimer saveTimer;
+  bool saved = mesh.save(_options.m_saveFile);
+  saveTimer.stop(0.0, _record, io_results[PHASE_SAVE]);
+  io_results[PHASE_SAVE].m_nElements = mesh.getNumFaces();
+  std::remove(_options.m_saveFile.c_str());
+  if (!saved)
+  {
+    std::cerr<<_options.m_saveFile<<": could not be written\n";
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief print the results of one file
+/// @param[in] _file the obj file
+/// @param[in] _results one result per phase
+/// @param[in] _csv true for comma separated values
+//----------------------------------------------------------------------------------------------------------------------
+void printResults(const std::string &_file, PhaseResult *_results, bool _csv)
+{
+  for (unsigned int p=0; p<NUM_PHASES; ++p)
+  {
+    PhaseResult &result = _results[p];
+    std::vector<double> &ms = result.m_ms;
+    std::sort(ms.begin(), ms.end());
+    double median = ms.size() % 2 ? ms[ms.size()/2] : 0.5*(ms[ms.size()/2-1] + ms[ms.size()/2]);
+    double nsPerElement = result.m_nElements ? median*1e6/result.m_nElements : 0.0;
+    double perSecond = median > 0.0 ? result.m_nElements/(median*1e-3) : 0.0;
+    if (_csv)
+    {
+      printf("%s,%s,%u,%u,%.4f,%.4f,%.2f,%.0f,", _file.c_str(), s_phaseNames[p], result.m_nElements,
+             (unsigned int)ms.size(), ms.front(), median, nsPerElement, perSecond);
+      if (result.m_countsAllocs)
+      {
+        printf("%llu,%llu\n", result.m_nAllocs, result.m_allocBytes);
+      }
+      else
+      {
+        printf(",\n");
+      }
+    }
+    else
+    {
+      printf("%-36s %-9s %10u %10.3f %10.3f %10.1f %14.0f ", _file.c_str(), s_phaseNames[p], result.m_nElements,
+             ms.front(), median, nsPerElement, perSecond);
+      if (result.m_countsAllocs)
+      {
+        printf("%10llu %14llu\n", result.m_nAllocs, result.m_allocBytes);
+      }
+      else
+      {
+        printf("%10s %14s\n", "-", "-");
+      }
+    }
+  }
+  fflush(stdout);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief load, decimate and save one mesh in this process
+/// @param[in] _file the obj file
+/// @param[in] _options the options
+/// @param[in] _nThreads the worker threads to use
+/// @returns the times, without the peak memory
+//----------------------------------------------------------------------------------------------------------------------
+ScalingResult runPipeline(const std::string &_file, const BenchOptions &_options, unsigned int _nThreads)
+{
+  ScalingResult result;
+  result.m_ok = false;
+  result.m_nFaces = 0;
+  result.m_loadMs = result.m_decimateMs = result.m_saveMs = 0.0;
+  result.m_peakMB = -1.0;
+  setNumWorkerThreads(_nThreads);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  LODMesh mesh(_file, _options.m_weldEpsilon);
+  if (!mesh.getLoaded() || mesh.getNumFaces() == 0)
+  {
+    return result;
+  }
+  std::chrono::steady_clock::time_point loaded = std::chrono::steady_clock::now();
+  mesh.setBatchTolerance(_options.m_batchTolerance);
+  mesh.setLazyCosts(_options.m_lazy);
+  LODMesh *lod = mesh.createLOD((unsigned int)(_options.m_lodRatio*mesh.getNumFaces()), _options.m_metric);
+  std::chrono::steady_clock::time_point decimated = std::chrono::steady_clock::now();
+  result.m_ok = lod->save(_options.m_saveFile);
+  std::chrono::steady_clock::time_point saved = std::chrono::steady_clock::now();
+  delete lod;
+  std::remove(_options.m_saveFile.c_str());
+
+  result.m_nFaces = mesh.getNumFaces();
+  result.m_loadMs = std::chrono::duration<double, std::milli>(loaded - start).count();
+  result.m_decimateMs = std::chrono::duration<double, std::milli>(decimated - loaded).count();
+  result.m_saveMs = std::chrono::duration<double, std::milli>(saved - decimated).count();
+  return result;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief runPipeline in a child process where there is fork, so the peak memory is that run's alone and a
+///   run that runs out of memory doesn't take the benchmark down with it
+/// @param[in] _file the obj file
+/// @param[in] _options the options
+/// @param[in] _nThreads the worker threads to use
+/// @returns the times and peak memory
+//----------------------------------------------------------------------------------------------------------------------
+ScalingResult runIsolated(const std::string &_file, const BenchOptions &_options, unsigned int _nThreads)
+{
+#if defined(__unix__) || defined(__APPLE__)
+  ScalingResult result;
+  result.m_ok = false;
+  int fds[2];
+  if (pipe(fds) != 0)
+  {
+    return runPipeline(_file, _options, _nThreads);
+  }
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0)
+  {
+    close(fds[0]);
+    ScalingResult child = runPipeline(_file, _options, _nThreads);
+    ssize_t written = write(fds[1], &child, sizeof(child));
+    _exit(written == sizeof(child) ? 0 : 1);
+  }
+  close(fds[1]);
+  bool received = pid > 0 && read(fds[0], &result, sizeof(result)) == sizeof(result);
+  close(fds[0]);
+  struct rusage usage;
+  int status = 0;
+  if (pid > 0 && wait4(pid, &status, 0, &usage) == pid && received)
+  {
+#if defined(__APPLE__)
+    result.m_peakMB = usage.ru_maxrss/(1024.0*1024.0);
+#else
+    result.m_peakMB = usage.ru_maxrss/1024.0;
+#endif
+  }
+  else
+  {
+    result.m_ok = false;
+  }
+  return result;
+#else
+  return runPipeline(_file, _options, _nThreads);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief how fast something grew between two sizes, as the power of the size it grows with
+//----------------------------------------------------------------------------------------------------------------------
+double growthExponent(double _from, double _to, unsigned int _fromSize, unsigned int _toSize)
+{
+  if (_from <= 0.0 || _to <= 0.0 || _fromSize == _toSize)
+  {
+    return 0.0;
+  }
+  return std::log(_to/_from)/std::log(double(_toSize)/_fromSize);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief generate a mesh of each size and run the pipeline on it with each thread count
+/// @param[in] _options the options
+/// @returns 0 if every run worked
+//----------------------------------------------------------------------------------------------------------------------
+int runScaling(const BenchOptions &_options)
+{
+  static const char *s_shapeNames[] = {"sphere", "terrain", "torus"};
+  const char *shapeName = s_shapeNames[_options.m_shape];
+  if (_options.m_csv)
+  {
+    printf("shape,faces,threads,load_ms,decimate_ms,save_ms,total_ms,ns_per_face,peak_rss_mb,"
+           "time_exponent,rss_exponent\n");
+  }
+  else
+  {
+    printf("%s, LOD at %g of the faces, growth is the power of the face count since the size before\n", shapeName,
+           _options.m_lodRatio);
+    printf("%-10s %7s %10s %12s %10s %10s %10s %10s %11s %11s\n", "faces", "threads", "load ms", "decimate ms",
+           "save ms", "total ms", "ns/face", "peak MB", "time growth", "mem growth");
+  }
+
+  int status = 0;
+  std::vector<ScalingResult> previous(_options.m_threadCounts.size());
+  for (unsigned int s=0; s<_options.m_sizes.size(); ++s)
+  {
+    MeshGenerator generator(_options.m_shape, _options.m_sizes[s]);
+    std::stringstream fname;
+    fname<<_options.m_scratchDir<<"/lodgen-scale-"<<shapeName<<"-"<<generator.getNumFaces()<<".obj";
+    if (!generator.write(fname.str()))
+    {
+      std::cerr<<fname.str()<<": could not be written\n";
+      return 1;
+    }
+
+    for (unsigned int t=0; t<_options.m_threadCounts.size(); ++t)
+    {
+      ScalingResult result = runIsolated(fname.str(), _options, _options.m_threadCounts[t]);
+      if (!result.m_ok)
+      {
+        if (_options.m_csv)
+        {
+          printf("%s,%u,%u,,,,,,,,\n", shapeName, generator.getNumFaces(), _options.m_threadCounts[t]);
+        }
+        else
+        {
+          printf("%-10u %7u failed\n", generator.getNumFaces(), _options.m_threadCounts[t]);
+        }
+        status = 1;
+        previous[t] = result;
+        continue;
+      }
+      double total = result.m_loadMs + result.m_decimateMs + result.m_saveMs;
+      double nsPerFace = total*1e6/result.m_nFaces;
+      const ScalingResult &before = previous[t];
+      double beforeTotal = before.m_loadMs + before.m_decimateMs + before.m_saveMs;
+      bool growth = s > 0 && before.m_ok;
+      double timeGrowth = growth ? growthExponent(beforeTotal, total, before.m_nFaces, result.m_nFaces) : 0.0;
+      double memGrowth = growth ? growthExponent(before.m_peakMB, result.m_peakMB, before.m_nFaces,
+                                                 result.m_nFaces) : 0.0;
+      if (_options.m_csv)
+      {
+        printf("%s,%u,%u,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,", shapeName, result.m_nFaces, _options.m_threadCounts[t],
+               result.m_loadMs, result.m_decimateMs, result.m_saveMs, total, nsPerFace, result.m_peakMB);
+        if (growth)
+        {
+          printf("%.3f,%.3f\n", timeGrowth, memGrowth);
+        }
+        else
+        {
+          printf(",\n");
+        }
+      }
+      else
+      {
+        printf("%-10u %7u %10.1f %12.1f %10.1f %10.1f %10.1f %10.1f ", result.m_nFaces, _options.m_threadCounts[t],
+               result.m_loadMs, result.m_decimateMs, result.m_saveMs, total, nsPerFace, result.m_peakMB);
+        if (growth)
+        {
+          printf("%11.2f %11.2f\n", timeGrowth, memGrowth);
+        }
+        else
+        {
+          printf("%11s %11s\n", "-", "-");
+        }
+      }
+      fflush(stdout);
+      previous[t] = result;
+    }
+
+    if (!_options.m_keep)
+    {
+      std::remove(fname.str().c_str());
+    }
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief run the collapse loop of every file, or of a generated torus, with every metric and the lazy updates and
+///   count what it allocates
+/// @param[in] _options the options
+/// @returns 0 if every loop was measured and none allocated
+//----------------------------------------------------------------------------------------------------------------------
+int checkAllocs(const BenchOptions &_options)
+{
+  std::vector<std::string> files = _options.m_files;
+  std::string generated;
+  if (files.empty())
+  {
+    MeshGenerator generator(SHAPE_TORUS, s_allocCheckFaces);
+    std::stringstream fname;
+    fname<<_options.m_scratchDir<<"/lodgen-allocs-torus-"<<generator.getNumFaces()<<".obj";
+    generated = fname.str();
+    if (!generator.write(generated))
+    {
+      std::cerr<<generated<<": could not be written\n";
+      return 1;
+    }
+    files.push_back(generated);
+  }
+
+  int status = 0;
+  for (unsigned int f=0; f<files.size(); ++f)
+  {
+    for (unsigned int c=0; c<sizeof(s_allocChecks)/sizeof(s_allocChecks[0]); ++c)
+    {
+      // batches are left out, their worker threads allocate as they start
+      BenchOptions options = _options;
+      options.m_metric = s_allocChecks[c].m_metric;
+      options.m_lazy = s_allocChecks[c].m_lazy;
+      options.m_batchTolerance = 0.0f;
+      PhaseResult results[NUM_PHASES];
+      if (!runFile(files[f], options, false, results))
+      {
+        std::cerr<<files[f]<<": could not load mesh\n";
+        status = 1;
+        break;
+      }
+      // a loop that was never measured would pass with 0, so that fails as well
+      const PhaseResult &collapse = results[PHASE_COLLAPSE];
+      if (!collapse.m_loopMeasured)
+      {
+        printf("%s %s: collapse loop not measured\n", files[f].c_str(), s_allocChecks[c].m_name);
+        status = 1;
+      }
+      else
+      {
+        printf("%s %s: %llu allocations inside the collapse loop\n", files[f].c_str(), s_allocChecks[c].m_name,
+               collapse.m_nLoopAllocs);
+        if (collapse.m_nLoopAllocs > 0)
+        {
+          status = 1;
+        }
+      }
+      fflush(stdout);
+    }
+  }
+
+  if (!generated.empty() && !_options.m_keep)
+  {
+    std::remove(generated.c_str());
+  }
+  return status;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  BenchOptions options;
+  if (!parseArgs(argc, argv, options))
+  {
+    printUsage();
+    return 1;
+  }
+  // every load has to parse the file, a cache hit would skip the load and cost phases
+  LODCache::setEnabled(false);
+  if (options.m_scaling)
+  {
+    return runScaling(options);
+  }
+  setNumWorkerThreads(options.m_nThreads);
+  if (options.m_checkAllocs)
+  {
+    return checkAllocs(options);
+  }
+
+  if (options.m_csv)
+  {
+    printf("file,phase,elements,runs,min_ms,median_ms,ns_per_element,elements_per_s,allocs,alloc_bytes\n");
+  }
+  else
+  {
+    printf("%u worker threads, %u runs after %u warm up, %s face kernels %u wide\n", getNumWorkerThreads(),
+           options.m_nRuns, options.m_nWarmups, getFaceKernelName(), getFaceKernelWidth());
+    printf("%-36s %-9s %10s %10s %10s %10s %14s %10s %14s\n", "file", "phase", "elements", "min ms", "median ms",
+           "ns/elem", "elem/s", "allocs", "bytes");
+  }
+
+  int status = 0;
+  for (unsigned int f=0; f<options.m_files.size(); ++f)
+  {
+    const std::string &file = options.m_files[f];
+    PhaseResult results[NUM_PHASES];
+    bool ok = true;
+    for (unsigned int run=0; ok && run<options.m_nWarmups+options.m_nRuns; ++run)
+    {
+      ok = runFile(file, options, run >= options.m_nWarmups, results);
+    }
+    if (!ok)
+    {
+      std::cerr<<file<<": could not load mesh\n";
+      status = 1;
+      continue;
+    }
+    printResults(file, results, options.m_csv);
+  }
+  return status;
+}
@@ -0,0 +1,24 @@
+# This specifies the exe name
+TARGET=lodgen-cli
+# location of .o files
+OBJECTS_DIR=obj
+# headless tool, no Qt or GL needed
+CONFIG-=qt
+CONFIG+=console
+# on a mac we don't create a .app bundle file ( for ease of multiplatform use)
+CONFIG-=app_bundle
+SOURCES+=$$PWD/src/*.cpp
+# build the shared LOD core in
+include($$PWD/../core/LODCore.pri)
+# where our exe is going to live (root of project, next to the GUI)
+DESTDIR=$$PWD/../
+# use this to suppress some warning from boost
+unix*:QMAKE_CXXFLAGS_WARN_ON += "-Wno-unused-parameter"
+macx:INCLUDEPATH+=/usr/local/include/
+unix:LIBS += -pthread
+unix:QMAKE_CXXFLAGS += -pthread
+
+win32: {
+        INCLUDEPATH+=-I $$(BOOST)/include/boost-1_61
+        DEFINES+=_USE_MATH_DEFINES
+}
@@ -0,0 +1,363 @@
+/****************************************************************************
+lodgen-cli, runs the LODGenerator decimator over a batch of obj files without
+Qt, NGL or an OpenGL context so it can be used on build machines with no GPU
+****************************************************************************/
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+
+#include "LODMesh.h"
+#include "ParallelFor.h"
+#include "LODCache.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief a LOD target, either an absolute face count or a ratio of the base mesh's faces
+//----------------------------------------------------------------------------------------------------------------------
+struct LODTarget {
+  bool m_ratio; ///< true if m_value is a ratio of the base face count
+  float m_value; ///< the face count or ratio
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the options passed on the command line
+//----------------------------------------------------------------------------------------------------------------------
+struct CLIOptions {
+  std::vector<LODTarget> m_targets; ///< the LODs to make for every file
+  std::vector<std::string> m_files; ///< the obj files to process
+  std::string m_outDir; ///< where to write the LODs, empty to write next to each input
+  unsigned int m_nThreads; ///< number of files processed at once
+  LODCostMetric m_metric; ///< the edge collapse cost to decimate with
+  float m_batchTolerance; ///< see LODMesh::setBatchTolerance, 0 to decimate one collapse at a time
+  bool m_lazy; ///< see LODMesh::setLazyCosts
+  float m_weldEpsilon; ///< see LODMesh::setWeldEpsilon, negative to leave the vertices as they are
+  bool m_timing; ///< print how long the decimation and each extraction took
+  unsigned int m_precision; ///< significant digits written for each float, 0 for the shortest round trip
+  bool m_stats; ///< write the LODStats of each file as <name>_stats.json next to its LODs
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief used so the worker threads don't mix up their output lines
+//----------------------------------------------------------------------------------------------------------------------
+static std::mutex s_printMutex;
+
+//----------------------------------------------------------------------------------------------------------------------
+void printUsage()
+{
+  std::cout<<"usage: lodgen-cli [options] file.obj [file.obj ...]\n"
+           <<"  -t, --targets LIST  comma separated LOD targets, each a face count (5000)\n"
+           <<"                      or a ratio of the base faces (50% or 0.5)\n"
+           <<"  -j, --threads N     number of files to process at once (default all cores)\n"
+           <<"  -o, --output DIR    directory for the LODs (default next to each input)\n"
+           <<"  -m, --metric NAME   edge collapse cost, melax (default), qem or qem-optimal\n"
+           <<"  -b, --batch TOL     decimate in parallel rounds, each picking from the cheapest\n"
+           <<"                      TOL of the vertices left (eg. 0.05, default 0 is serial)\n"
+           <<"      --lazy          only work a melax cost out again once its vertex is the\n"
+           <<"                      cheapest, faster but not exactly cheapest first\n"
+           <<"      --weld EPS      merge vertices within EPS of each other as the file is\n"
+           <<"                      loaded, eg. copies along uv seams. 0 only merges exact\n"
+           <<"                      duplicates (default off)\n"
+           <<"  -p, --precision N   significant digits of each written float (default 6,\n"
+           <<"                      0 for the shortest text that reads back exactly)\n"
+           <<"      --no-cache      don't read or write the .lodc cache next to each input\n"
+           <<"      --timing        print the decimation and LOD extraction times\n"
+           <<"      --stats         write the phase timings and counters of each file to\n"
+           <<"                      <name>_stats.json next to its LODs\n"
+           <<"  -h, --help          show this message\n"
+           <<"each LOD is written as <name>_lod<n>.obj in the order the targets are given\n"
+           <<"the vector instruction set is picked from the cpu, LODGEN_SIMD=scalar, sse2, avx2 or\n"
+           <<"avx512 asks for a narrower one\n";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool parseTargets(const std::string &_list, std::vector<LODTarget> &o_targets)
+{
+  std::stringstream stream(_list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    if (item.empty())
+    {
+      continue;
+    }
+    LODTarget target;
+    char *end;
+    target.m_value = strtof(item.c_str(), &end);
+    target.m_ratio = false;
+    if (*end == '%')
+    {
+      target.m_value /= 100.0f;
+      target.m_ratio = true;
+      ++end;
+    }
+    else if (item.find('.') != std::string::npos)
+    {
+      target.m_ratio = true;
+    }
+    if (*end != '\0' || target.m_value <= 0.0f || (target.m_ratio && target.m_value > 1.0f))
+    {
+      std::cerr<<"invalid LOD target "<<item<<"\n";
+      return false;
+    }
+    o_targets.push_back(target);
+  }
+  return !o_targets.empty();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool parseArgs(int _argc, char **_argv, CLIOptions &o_options)
+{
+  o_options.m_nThreads = std::thread::hardware_concurrency();
+  o_options.m_metric = COST_MELAX;
+  o_options.m_batchTolerance = 0.0f;
+  o_options.m_lazy = false;
+  o_options.m_weldEpsilon = -1.0f;
+  o_options.m_timing = false;
+  o_options.m_precision = 6;
+  o_options.m_stats = false;
+  for (int i=1; i<_argc; ++i)
+  {
+    std::string arg = _argv[i];
+    if (arg == "-h" || arg == "--help")
+    {
+      return false;
+    }
+    else if ((arg == "-t" || arg == "--targets") && i+1 < _argc)
+    {
+      if (!parseTargets(_argv[++i], o_options.m_targets))
+      {
+        return false;
+      }
+    }
+    else if ((arg == "-j" || arg == "--threads") && i+1 < _argc)
+    {
+      o_options.m_nThreads = atoi(_argv[++i]);
+    }
+    else if ((arg == "-o" || arg == "--output") && i+1 < _argc)
+    {
+      o_options.m_outDir = _argv[++i];
+    }
+    else if ((arg == "-m" || arg == "--metric") && i+1 < _argc)
+    {
+      std::string metric = _argv[++i];
+      if (metric == "melax")
+      {
+        o_options.m_metric = COST_MELAX;
+      }
+      else if (metric == "qem")
+      {
+        o_options.m_metric = COST_QEM;
+      }
+      else if (metric == "qem-optimal")
+      {
+        o_options.m_metric = COST_QEM_OPTIMAL;
+      }
+      else
+      {
+        std::cerr<<"unknown metric "<<metric<<"\n";
+        return false;
+      }
+    }
+    else if ((arg == "-b" || arg == "--batch") && i+1 < _argc)
+    {
+      char *end;
+      o_options.m_batchTolerance = strtof(_argv[++i], &end);
+      if (*end != '\0' || o_options.m_batchTolerance < 0.0f || o_options.m_batchTolerance > 1.0f)
+      {
+        std::cerr<<"invalid batch tolerance "<<_argv[i]<<"\n";
+        return false;
+      }
+    }
+    else if (arg == "--lazy")
+    {
+      o_options.m_lazy = true;
+    }
+    else if (arg == "--weld" && i+1 < _argc)
+    {
+      char *end;
+      o_options.m_weldEpsilon = strtof(_argv[++i], &end);
+      if (*end != '\0' || !(o_options.m_weldEpsilon >= 0.0f))
+      {
+        std::cerr<<"invalid weld epsilon "<<_argv[i]<<"\n";
+        return false;
+      }
+    }
+    else if ((arg == "-p" || arg == "--precision") && i+1 < _argc)
+    {
+      char *end;
+      long precision = strtol(_argv[++i], &end, 10);
+      if (*end != '\0' || precision < 0 || precision > 17)
+      {
+        std::cerr<<"invalid precision "<<_argv[i]<<"\n";
+        return false;
+      }
+      o_options.m_precision = (unsigned int)precision;
+    }
+    else if (arg == "--no-cache")
+    {
+      LODCache::setEnabled(false);
+    }
+    else if (arg == "--timing")
+    {
+      o_options.m_timing = true;
+    }
+    else if (arg == "--stats")
+    {
+      if (!LODStats::getEnabled())
+      {
+        std::cerr<<"--stats needs the core built with LOD_STATS\n";
+        return false;
+      }
+      o_options.m_stats = true;
+    }
+    else if (!arg.empty() && arg[0] == '-')
+    {
+      std::cerr<<"unknown option "<<arg<<"\n";
+      return false;
+    }
+    else
+    {
+      o_options.m_files.push_back(arg);
+    }
+  }
+  if (o_options.m_nThreads == 0)
+  {
+    o_options.m_nThreads = 1;
+  }
+  return !o_options.m_targets.empty() && !o_options.m_files.empty();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string outputFileName(const std::string &_file, const std::string &_outDir, const std::string &_suffix)
+{
+  std::string::size_type slash = _file.find_last_of("/\\");
+  std::string dir = slash == std::string::npos ? "" : _file.substr(0, slash+1);
+  std::string name = slash == std::string::npos ? _file : _file.substr(slash+1);
+  std::string::size_type dot = name.find_last_of('.');
+  if (dot != std::string::npos)
+  {
+    name = name.substr(0, dot);
+  }
+  if (!_outDir.empty())
+  {
+    dir = _outDir;
+    if (dir[dir.size()-1] != '/' && dir[dir.size()-1] != '\\')
+    {
+      dir.append("/");
+    }
+  }
+  return dir + name + _suffix;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string lodFileName(const std::string &_file, const std::string &_outDir, unsigned int _lod)
+{
+  std::stringstream suffix;
+  suffix<<"_lod"<<_lod<<".obj";
+  return outputFileName(_file, _outDir, suffix.str());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool processFile(const std::string &_file, const CLIOptions &_options)
+{
+  LODMesh mesh(_file, _options.m_weldEpsilon);
+  if (!mesh.getLoaded() || mesh.getNumFaces() == 0)
+  {
+    std::lock_guard<std::mutex> lock(s_printMutex);
+    std::cerr<<_file<<": could not load mesh\n";
+    return false;
+  }
+
+  // work out every target first so the whole chain comes from one walk of the collapse record
+  std::vector<unsigned int> nFaces(_options.m_targets.size());
+  for (unsigned int i=0; i<_options.m_targets.size(); ++i)
+  {
+    const LODTarget &target = _options.m_targets[i];
+    nFaces[i] = target.m_ratio ? (unsigned int)(target.m_value*mesh.getNumFaces()) :
+                                 (unsigned int)target.m_value;
+  }
+  mesh.setBatchTolerance(_options.m_batchTolerance);
+  mesh.setLazyCosts(_options.m_lazy);
+  std::vector<LODMesh*> lods = mesh.createLODChain(nFaces, _options.m_metric);
+  if (_options.m_timing)
+  {
+    std::lock_guard<std::mutex> lock(s_printMutex);
+    std::cout<<_file<<": decimated in "<<mesh.getBuildTime()<<" ms\n";
+  }
+
+  bool ok = true;
+  LODStats stats = mesh.getStats();
+  for (unsigned int i=0; i<lods.size(); ++i)
+  {
+    std::string outFile = lodFileName(_file, _options.m_outDir, i+1);
+    bool saved = lods[i]->save(outFile, _options.m_precision);
+    ok = ok && saved;
+    {
+      std::lock_guard<std::mutex> lock(s_printMutex);
+      std::cout<<_file<<": "<<mesh.getNumFaces()<<" -> "<<lods[i]->getNumFaces()<<" faces "
+               <<(saved ? "written to " : "FAILED writing ")<<outFile;
+      if (_options.m_timing)
+      {
+        std::cout<<" (extracted in "<<lods[i]->getExtractTime()<<" ms)";
+      }
+      std::cout<<"\n";
+    }
+    stats.add(lods[i]->getStats());
+    delete lods[i];
+  }
+
+  if (_options.m_stats)
+  {
+    std::string statsFile = outputFileName(_file, _options.m_outDir, "_stats.json");
+    if (!stats.writeJSON(statsFile))
+    {
+      std::lock_guard<std::mutex> lock(s_printMutex);
+      std::cerr<<_file<<": could not write "<<statsFile<<"\n";
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+  CLIOptions options;
+  if (!parseArgs(argc, argv, options))
+  {
+    printUsage();
+    return 1;
+  }
+
+  // each worker takes the next file until there are none left, every LODMesh is independent
+  std::atomic<unsigned int> nextFile(0);
+  std::atomic<unsigned int> nFailed(0);
+  unsigned int nThreads = std::min<unsigned int>(options.m_nThreads, options.m_files.size());
+  // the loader splits each file over threads too, share the hardware threads out so they aren't oversubscribed
+  setNumWorkerThreads(std::max(1u, getNumWorkerThreads()/std::max(1u, nThreads)));
+  std::vector<std::thread> workers;
+  for (unsigned int i=0; i<nThreads; ++i)
+  {
+    workers.push_back(std::thread([&]()
+    {
+      unsigned int file;
+      while ((file = nextFile++) < options.m_files.size())
+      {
+        if (!processFile(options.m_files[file], options))
+        {
+          ++nFailed;
+        }
+      }
+    }));
+  }
+  for (unsigned int i=0; i<workers.size(); ++i)
+  {
+    workers[i].join();
+  }
+
+  return nFailed == 0 ? 0 : 1;
+}
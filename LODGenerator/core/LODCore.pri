@@ -0,0 +1,9 @@
+# the LOD core (loading, decimation and saving) has no Qt, NGL or GL dependency so it can be
+# shared between the GUI and the command line tool. include this file to build it in
+INCLUDEPATH+=$$PWD/include
+DEPENDPATH+=$$PWD/include
+SOURCES+=$$PWD/src/*.cpp
+HEADERS+=$$PWD/include/*.h
+CONFIG+=c++17
+# gathers the LODStats timings and counters, remove to compile the collection out
+DEFINES+=LOD_STATS
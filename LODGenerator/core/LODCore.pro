@@ -0,0 +1,15 @@
+# builds the LOD core on its own as a static library
+TARGET=LODCore
+TEMPLATE=lib
+CONFIG+=staticlib
+# the core doesn't use any Qt
+CONFIG-=qt
+# location of .o files
+OBJECTS_DIR=obj
+# where the library is going to live
+DESTDIR=./lib
+include($$PWD/LODCore.pri)
+# use this to suppress some warning from boost
+unix*:QMAKE_CXXFLAGS_WARN_ON += "-Wno-unused-parameter"
+macx:INCLUDEPATH+=/usr/local/include/
+win32:INCLUDEPATH+=-I $$(BOOST)/include/boost-1_61
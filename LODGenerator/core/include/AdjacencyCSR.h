@@ -0,0 +1,372 @@
+#ifndef ADJACENCYCSR_H_
+#define ADJACENCYCSR_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file AdjacencyCSR.h
+/// @brief packed storage for the vertex and face rings of the WorkingMesh a LODMesh decimates
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <new>
+#include <vector>
+#include <mutex>
+#include <cstring>
+#include <algorithm>
+
+template <class T> class AdjacencyCSR;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class AdjList "core/include/AdjacencyCSR.h"
+/// @brief one vertex's adjacency list, a slice of the block an AdjacencyCSR lays every list out in. It has the
+///   parts of the std::vector interface the decimation uses, and the same element order after any of them, so
+///   it can stand in for the per vertex vectors without changing which collapse happens when
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 replaces the std::vector adjacency of each Vertex
+//----------------------------------------------------------------------------------------------------------------------
+template <class T>
+class AdjList
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, an empty list with no room until AdjacencyCSR::assign gives it some
+  //----------------------------------------------------------------------------------------------------------------------
+  AdjList():
+    m_data(NULL),
+    m_size(0),
+    m_capacity(0),
+    m_owner(NULL){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of entries
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int size() const { return m_size; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is the list empty
+  //----------------------------------------------------------------------------------------------------------------------
+  bool empty() const { return m_size == 0; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get an entry
+  /// @param[in] _i the index, less than size
+  //----------------------------------------------------------------------------------------------------------------------
+  T& operator[]( unsigned int _i ) { return m_data[_i]; }
+  const T& operator[]( unsigned int _i ) const { return m_data[_i]; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the first entry, the entries are contiguous so this works as an iterator
+  //----------------------------------------------------------------------------------------------------------------------
+  T* begin() { return m_data; }
+  const T* begin() const { return m_data; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get one past the last entry
+  //----------------------------------------------------------------------------------------------------------------------
+  T* end() { return m_data + m_size; }
+  const T* end() const { return m_data + m_size; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief remove every entry, the room stays with the list
+  //----------------------------------------------------------------------------------------------------------------------
+  void clear() { m_size = 0; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add an entry at the end, the list moves to a slice at least twice the size if it is full
+  /// @param[in] _t the entry
+  //----------------------------------------------------------------------------------------------------------------------
+  void push_back( const T &_t )
+  {
+    if (m_size == m_capacity)
+    {
+      m_owner->grow(*this);
+    }
+    m_data[m_size++] = _t;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief remove a run of entries keeping the order of the rest, eg. with std::remove
+  /// @param[in] _first the first entry to remove
+  /// @param[in] _last one past the last entry to remove
+  //----------------------------------------------------------------------------------------------------------------------
+  void erase( T *_first, T *_last )
+  {
+    T *e = end();
+    std::memmove(_first, _last, (e-_last)*sizeof(T));
+    m_size -= (unsigned int)(_last-_first);
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the storage sets up and moves the slice
+  //----------------------------------------------------------------------------------------------------------------------
+  friend class AdjacencyCSR<T>;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the first entry of the slice
+  //----------------------------------------------------------------------------------------------------------------------
+  T *m_data;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the number of entries
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_size;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the number of entries the slice has room for
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_capacity;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the storage the slice is in, asked for a bigger one when it is full
+  //----------------------------------------------------------------------------------------------------------------------
+  AdjacencyCSR<T> *m_owner;
+
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class AdjacencyCSR "core/include/AdjacencyCSR.h"
+/// @brief compressed sparse row storage for one kind of adjacency of every working vertex. build lays the lists
+///   out in one block in vertex order, straight from the offsets of the base mesh's CSR lists, with a few spare
+///   entries after each so most collapses update them in place. A list that outgrows its slice is moved to a
+///   new one of the next power of two size. The old slice goes on a free list for its size, as do the slices
+///   given back by release, and new slices come from those free lists before any overflow block is carved up,
+///   so once a decimation is under way lists move around without allocating. The free lists are kept inside
+///   the free slices themselves. Everything is released at once by clear.
+///
+///   Lists can be grown from several threads at once, eg. by batch decimation, everything else must only be
+///   called from one thread (or for different lists, as WorkingMesh::build does)
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 replaces the std::vector adjacency of each Vertex
+//----------------------------------------------------------------------------------------------------------------------
+template <class T>
+class AdjacencyCSR
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, nothing is allocated until build
+  //----------------------------------------------------------------------------------------------------------------------
+  AdjacencyCSR():
+    m_block(NULL),
+    m_nLists(0),
+    m_overflowNext(NULL),
+    m_overflowEnd(NULL),
+    m_allocatedBytes(0)
+  {
+    std::fill(m_free, m_free+s_nFreeLists, (T*)NULL);
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief releases all the lists
+  //----------------------------------------------------------------------------------------------------------------------
+  ~AdjacencyCSR() { clear(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief allocate the block for a set of lists
+  /// @param[in] _start CSR offsets, list i starts with _start[i] entries and _start has one more than the lists
+  //----------------------------------------------------------------------------------------------------------------------
+  void build( const std::vector<unsigned int> &_start )
+  {
+    clear();
+    m_start = _start.data();
+    m_nLists = _start.size()-1;
+    size_t n = _start.back() + (size_t)s_slack*m_nLists;
+    m_block = static_cast<T*>(::operator new(n*sizeof(T)));
+    m_allocatedBytes += n*sizeof(T);
+    // the first overflow block comes now, big enough that most decimations never need another, and room to
+    // keep track of more so that doesn't allocate as well
+    m_overflow.reserve(64);
+    newOverflowBlock(std::max<size_t>(s_overflowBlockSize, _start.back()/s_overflowFraction));
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief point a list at its slice of the block, with its size from the offsets given to build. The caller
+  ///   fills in the entries
+  /// @param[in] _i the list's index in the offsets
+  /// @param[out] o_list the list
+  //----------------------------------------------------------------------------------------------------------------------
+  void assign( unsigned int _i, AdjList<T> &o_list )
+  {
+    o_list.m_data = m_block + m_start[_i] + (size_t)s_slack*_i;
+    o_list.m_size = m_start[_i+1] - m_start[_i];
+    o_list.m_capacity = o_list.m_size + s_slack;
+    o_list.m_owner = this;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief give a list's slice back to be reused by lists that grow, the list is left empty with no room.
+  ///   Can be called from several threads at once like push_back
+  /// @param[in,out] io_list the list
+  //----------------------------------------------------------------------------------------------------------------------
+  void release( AdjList<T> &io_list )
+  {
+    if (io_list.m_data && isReusable(io_list.m_capacity))
+    {
+      std::lock_guard<std::mutex> lock(m_overflowMutex);
+      freeSlice(io_list.m_data, io_list.m_capacity);
+    }
+    io_list.m_data = NULL;
+    io_list.m_size = 0;
+    io_list.m_capacity = 0;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the bytes of the block and every overflow block allocated since the storage was made
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long getAllocatedBytes() const { return m_allocatedBytes; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief release the block and the overflow blocks. The lists pointing into them mustn't be used after
+  //----------------------------------------------------------------------------------------------------------------------
+  void clear()
+  {
+    ::operator delete(m_block);
+    m_block = NULL;
+    m_nLists = 0;
+    for (unsigned int i=0; i<m_overflow.size(); ++i)
+    {
+      ::operator delete(m_overflow[i]);
+    }
+    m_overflow.clear();
+    m_overflowNext = NULL;
+    m_overflowEnd = NULL;
+    std::fill(m_free, m_free+s_nFreeLists, (T*)NULL);
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief full lists ask to grow
+  //----------------------------------------------------------------------------------------------------------------------
+  friend class AdjList<T>;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief spare entries after each list in the block. A collapse adds the neighbours of u to v, so this
+  ///   covers most of what a vertex gains before enough of its own neighbours go
+  //----------------------------------------------------------------------------------------------------------------------
+  static const unsigned int s_slack = 4;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief entries in each overflow block, unless a list needs more
+  //----------------------------------------------------------------------------------------------------------------------
+  static const unsigned int s_overflowBlockSize = 16384;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the first overflow block has room for this fraction of the entries build lays out, the lists
+  ///   outgrowing their slices seldom need more over a whole decimation once the free slices are reused
+  //----------------------------------------------------------------------------------------------------------------------
+  static const unsigned int s_overflowFraction = 4;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief number of free lists, one for each power of two slice size
+  //----------------------------------------------------------------------------------------------------------------------
+  static const unsigned int s_nFreeLists = 32;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move a full list to a new slice of the next power of two size, at least twice what it had
+  /// @param[in,out] io_list the list
+  //----------------------------------------------------------------------------------------------------------------------
+  void grow( AdjList<T> &io_list )
+  {
+    unsigned int sizeClass = 0;
+    while ((1u << sizeClass) < s_slack || (1u << sizeClass) < io_list.m_capacity*2)
+    {
+      ++sizeClass;
+    }
+    unsigned int capacity = 1u << sizeClass;
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+    T *data = m_free[sizeClass];
+    if (data)
+    {
+      m_free[sizeClass] = nextFree(data);
+    }
+    else
+    {
+      if ((size_t)(m_overflowEnd-m_overflowNext) < capacity)
+      {
+        newOverflowBlock(capacity > s_overflowBlockSize ? capacity : s_overflowBlockSize);
+      }
+      data = m_overflowNext;
+      m_overflowNext += capacity;
+    }
+    if (io_list.m_size > 0)
+    {
+      std::memcpy(data, io_list.m_data, io_list.m_size*sizeof(T));
+    }
+    // only once the entries are copied out, the free list link is written over the start of the slice
+    freeSlice(io_list.m_data, io_list.m_capacity);
+    io_list.m_data = data;
+    io_list.m_capacity = capacity;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief start carving slices from a new overflow block, the rest of the current one is left
+  /// @param[in] _n the entries in the block
+  //----------------------------------------------------------------------------------------------------------------------
+  void newOverflowBlock( size_t _n )
+  {
+    m_overflowNext = static_cast<T*>(::operator new(_n*sizeof(T)));
+    m_overflowEnd = m_overflowNext + _n;
+    m_overflow.push_back(m_overflowNext);
+    m_allocatedBytes += _n*sizeof(T);
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief put a slice on the free list for its size. Only power of two slices big enough to hold the link are
+  ///   kept as grow only asks for those, the rest are just left. m_overflowMutex must be held
+  /// @param[in] _data the slice
+  /// @param[in] _capacity the number of entries it has room for
+  //----------------------------------------------------------------------------------------------------------------------
+  void freeSlice( T *_data, unsigned int _capacity )
+  {
+    if (!_data || !isReusable(_capacity))
+    {
+      return;
+    }
+    unsigned int sizeClass = 0;
+    while ((1u << sizeClass) < _capacity)
+    {
+      ++sizeClass;
+    }
+    std::memcpy(_data, &m_free[sizeClass], sizeof(T*));
+    m_free[sizeClass] = _data;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief can a slice go on a free list
+  /// @param[in] _capacity the number of entries it has room for
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool isReusable( unsigned int _capacity )
+  {
+    return (_capacity & (_capacity-1)) == 0 && _capacity*sizeof(T) >= sizeof(T*);
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the slice after a free one on its free list
+  /// @param[in] _data the free slice
+  //----------------------------------------------------------------------------------------------------------------------
+  static T* nextFree( T *_data )
+  {
+    T *next;
+    std::memcpy(&next, _data, sizeof(T*));
+    return next;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the storage can't be copied, the lists point into it
+  //----------------------------------------------------------------------------------------------------------------------
+  AdjacencyCSR( const AdjacencyCSR & );
+  AdjacencyCSR& operator=( const AdjacencyCSR & );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the block every list starts in, in list order
+  //----------------------------------------------------------------------------------------------------------------------
+  T *m_block;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the offsets given to build, only read by assign
+  //----------------------------------------------------------------------------------------------------------------------
+  const unsigned int *m_start;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the number of lists in the block
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nLists;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief blocks the lists that outgrew their slices were moved to
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<T *> m_overflow;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the next free entry of the current overflow block
+  //----------------------------------------------------------------------------------------------------------------------
+  T *m_overflowNext;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the end of the current overflow block
+  //----------------------------------------------------------------------------------------------------------------------
+  T *m_overflowEnd;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the first free slice of each power of two size, each links to the next in its first bytes
+  //----------------------------------------------------------------------------------------------------------------------
+  T *m_free[s_nFreeLists];
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief guards the overflow blocks and free lists so threads can grow lists together
+  //----------------------------------------------------------------------------------------------------------------------
+  std::mutex m_overflowMutex;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief see getAllocatedBytes
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long m_allocatedBytes;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
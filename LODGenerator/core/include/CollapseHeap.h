@@ -0,0 +1,141 @@
+#ifndef COLLAPSEHEAP_H_
+#define COLLAPSEHEAP_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file CollapseHeap.h
+/// @brief indexed binary min-heap of vertex collapse costs used by LODMesh
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "LODStats.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class CollapseHeap "core/include/CollapseHeap.h"
+/// @brief mutable priority queue of vertex ids ordered by their collapse cost, read from the cost array the
+///   heap was built with. Every vertex keeps a handle (its position in the heap, looked up by its id) so a
+///   single cost change can be restored with a sift up or down in O(log n) instead of re-sorting the whole
+///   queue.
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 replaces the sorted std::list of collapse costs
+//----------------------------------------------------------------------------------------------------------------------
+class CollapseHeap
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, creates an empty heap
+  //----------------------------------------------------------------------------------------------------------------------
+  CollapseHeap():
+    m_cost(NULL) { LOD_STAT(m_nOperations = 0;) }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief builds the heap of every vertex id in O(n)
+  /// @param[in] _cost the collapse cost of each vertex, kept and read by every later call so it must outlive
+  ///   the heap's use. Change a cost and call update to move its vertex
+  //----------------------------------------------------------------------------------------------------------------------
+  void build( const std::vector<float> &_cost );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief removes all the vertices from the heap
+  //----------------------------------------------------------------------------------------------------------------------
+  void clear();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is the heap empty
+  /// @returns true if there are no vertices left in the heap
+  //----------------------------------------------------------------------------------------------------------------------
+  bool empty() const { return m_heap.empty(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of vertices in the heap
+  /// @returns the number of vertices in the heap
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int size() const { return m_heap.size(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the cheapest vertex without removing it
+  /// @returns the id of the vertex with the lowest collapse cost
+  //----------------------------------------------------------------------------------------------------------------------
+  int top() const { return m_heap.front(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief remove and return the cheapest vertex
+  /// @returns the id of the vertex with the lowest collapse cost
+  //----------------------------------------------------------------------------------------------------------------------
+  int pop();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add a vertex to the heap
+  /// @param[in] _v the id of the vertex to add
+  //----------------------------------------------------------------------------------------------------------------------
+  void push( int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief restores the heap order after the collapse cost of _v has changed (decrease or increase key)
+  /// @param[in] _v the id of the vertex whose cost has changed
+  //----------------------------------------------------------------------------------------------------------------------
+  void update( int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief removes a vertex from anywhere in the heap
+  /// @param[in] _v the id of the vertex to remove
+  //----------------------------------------------------------------------------------------------------------------------
+  void remove( int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief finds out if a vertex is stored in the heap
+  /// @param[in] _v the id of the vertex to look for
+  /// @returns true if _v is in the heap
+  //----------------------------------------------------------------------------------------------------------------------
+  bool contains( int _v ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of pushes, updates and removals (pops included) since the heap was made
+  /// @returns the count, always 0 without LOD_STATS
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long getNumOperations() const
+  {
+#if defined(LOD_STATS)
+    return m_nOperations;
+#else
+    return 0;
+#endif
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief ordering of two vertices, cost first and then id so the order is deterministic
+  /// @returns true if _a should be collapsed before _b
+  //----------------------------------------------------------------------------------------------------------------------
+  bool lessCost( int _a, int _b ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move the entry at _pos up the heap until its parent is cheaper
+  /// @param[in] _pos the heap position to sift
+  //----------------------------------------------------------------------------------------------------------------------
+  void siftUp( unsigned int _pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move the entry at _pos down the heap until both children are more expensive
+  /// @param[in] _pos the heap position to sift
+  //----------------------------------------------------------------------------------------------------------------------
+  void siftDown( unsigned int _pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief store _v at heap position _pos and update its handle
+  //----------------------------------------------------------------------------------------------------------------------
+  void place( int _v, unsigned int _pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief restore the order after the cost of the vertex at _pos has changed either way
+  //----------------------------------------------------------------------------------------------------------------------
+  void reposition( unsigned int _pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the cost array given to build
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<float> *m_cost;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the binary heap of vertex ids, m_heap[0] is the cheapest vertex
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_heap;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief heap position of each vertex indexed by id, -1 if the vertex is not in the heap
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_handle;
+#if defined(LOD_STATS)
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief see getNumOperations
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long m_nOperations;
+#endif
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+#ifndef FACEKERNELS_H_
+#define FACEKERNELS_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernels.h
+/// @brief the face normals and the curvature term of the Melax cost, done several faces at a time with the widest
+///   vectors the cpu has so the decimator gets something from the vector units. The kernels are built for each
+///   instruction set and the one to use is picked from the cpu when they are first called, so one binary runs
+///   everywhere. The results are the same as doing the faces one at a time with LODVec3 whichever is used, the
+///   sums are done in the same order
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "LODVec3.h"
+
+// the vector kernels are only built on x86, everywhere else just has the scalar ones
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FACE_KERNELS_X86
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the instruction sets the kernels are built for, narrowest first
+//----------------------------------------------------------------------------------------------------------------------
+enum FaceKernelISA
+{
+  FACE_KERNELS_SCALAR, ///< one face at a time, for cpus with none of the others
+  FACE_KERNELS_SSE2,   ///< 4 faces at a time
+  FACE_KERNELS_AVX2,   ///< 8 faces at a time, gathering the normals and positions in one instruction
+  FACE_KERNELS_AVX512, ///< 16 faces at a time
+  NUM_FACE_KERNEL_ISAS
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the kernels of one instruction set, FaceKernels.cpp calls through the one it picks
+//----------------------------------------------------------------------------------------------------------------------
+struct FaceKernelTable {
+  const char *m_name; ///< the name LODGEN_SIMD takes for it, eg. avx2
+  unsigned int m_width; ///< faces done at once
+  void (*m_normals)( const float *_pos, const int *_faceVert, const int *_faces, unsigned int _nFaces,
+                     float *o_nx, float *o_ny, float *o_nz ); ///< calculateFaceNormals, _pos is xyz for each vertex
+  void (*m_normalRange)( const float *_pos, const int *_faceVert, unsigned int _begin, unsigned int _end,
+                         float *o_nx, float *o_ny, float *o_nz ); ///< calculateFaceNormalRange
+  float (*m_curvature)( const float *_nx, const float *_ny, const float *_nz, const int *_faces,
+                        unsigned int _nFaces, const int *_sideFaces,
+                        unsigned int _nSideFaces ); ///< calculateRingCurvature
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the instruction set the kernels use. It is the widest the cpu and the os support, unless the
+///   LODGEN_SIMD environment variable names a narrower one (scalar, sse2, avx2 or avx512), eg. to benchmark them
+//----------------------------------------------------------------------------------------------------------------------
+FaceKernelISA getFaceKernelISA();
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the name of the instruction set the kernels use, as LODGEN_SIMD takes it
+//----------------------------------------------------------------------------------------------------------------------
+const char* getFaceKernelName();
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the number of faces the kernels do at once
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int getFaceKernelWidth();
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief work out the unit normals of a list of faces, zero area faces get a zero normal
+/// @param[in] _pos the vertex positions
+/// @param[in] _faceVert the vertex id of each face corner, three per face
+/// @param[in] _faces the ids of the faces to do
+/// @param[in] _nFaces the number of ids in _faces
+/// @param[out] o_nx the x part of each face's normal, indexed by face id, only the faces in _faces are written
+/// @param[out] o_ny the y part, the same way
+/// @param[out] o_nz the z part, the same way
+//----------------------------------------------------------------------------------------------------------------------
+void calculateFaceNormals( const LODVec3 *_pos, const int *_faceVert, const int *_faces, unsigned int _nFaces,
+                           float *o_nx, float *o_ny, float *o_nz );
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief work out the unit normals of the faces [_begin, _end), as calculateFaceNormals
+/// @param[in] _pos the vertex positions
+/// @param[in] _faceVert the vertex id of each face corner, three per face
+/// @param[in] _begin the first face id
+/// @param[in] _end one past the last face id
+/// @param[out] o_nx the x part of each face's normal, indexed by face id
+/// @param[out] o_ny the y part
+/// @param[out] o_nz the z part
+//----------------------------------------------------------------------------------------------------------------------
+void calculateFaceNormalRange( const LODVec3 *_pos, const int *_faceVert, unsigned int _begin, unsigned int _end,
+                               float *o_nx, float *o_ny, float *o_nz );
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the curvature term of the Melax cost. Every face around the vertex is paired with every side face of
+///   the edge as one matrix of normal dot products, each face keeps the smallest (1-dot)/2 over the side faces
+///   and the largest of those is the curvature
+/// @param[in] _nx the x part of every face's normal, indexed by face id
+/// @param[in] _ny the y part
+/// @param[in] _nz the z part
+/// @param[in] _faces the ids of the faces around the vertex being removed
+/// @param[in] _nFaces the number of ids in _faces
+/// @param[in] _sideFaces the ids of the faces with both vertices of the edge
+/// @param[in] _nSideFaces the number of ids in _sideFaces, with none every face has a curvature of 1
+/// @returns the curvature, 0 if there are no faces
+//----------------------------------------------------------------------------------------------------------------------
+float calculateRingCurvature( const float *_nx, const float *_ny, const float *_nz,
+                              const int *_faces, unsigned int _nFaces,
+                              const int *_sideFaces, unsigned int _nSideFaces );
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
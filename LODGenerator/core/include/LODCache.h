@@ -0,0 +1,84 @@
+#ifndef LODCACHE_H_
+#define LODCACHE_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODCache.h
+/// @brief binary .lodc cache of a loaded mesh so reopening an obj skips the parse, adjacency and cost passes
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+class LODMesh;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class LODCache "core/include/LODCache.h"
+/// @brief reads and writes a versioned binary cache next to an obj (Batman.obj -> Batman.lodc). The cache holds
+///   the positions, normals, texture coords, triangle indices, bounds, the vertex adjacency as CSR lists and
+///   the initial collapse cost and target of every vertex. Every section is 8 byte aligned so the file is used
+///   in place through a MappedFile and copied straight into the mesh lists.
+///   A cache is only used if it was made from the same source: the source size must match, and if the
+///   modification time has changed a hash of the source contents must still match. It must also have been made
+///   with the same weld epsilon, see LODMesh::setWeldEpsilon
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 first version of the cache
+//----------------------------------------------------------------------------------------------------------------------
+class LODCache
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the cache file name used for an obj
+  /// @param[in] _objName the obj file name
+  /// @returns the name with its extension replaced by .lodc
+  //----------------------------------------------------------------------------------------------------------------------
+  static std::string getCacheName( const std::string &_objName );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief fill an empty mesh from the cache of an obj, including its adjacency lists and initial costs
+  /// @param[in] _objName the obj file name, its cache is found with getCacheName
+  /// @param[in,out] o_mesh the mesh to fill with its weld epsilon set, it is only changed if the cache is valid
+  /// @returns true if the cache existed, matched the source and was read
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool read( const std::string &_objName, LODMesh &o_mesh );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief write the cache for a mesh that was just loaded from an obj. The file is written to a temporary
+  ///   name and renamed so a half written cache is never read
+  /// @param[in] _objName the obj file name
+  /// @param[in] _source the contents of the obj, used for the hash
+  /// @param[in] _sourceSize the size of _source
+  /// @param[in] _mesh the loaded mesh with its adjacency lists and initial costs
+  /// @returns true if the cache was written
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool write( const std::string &_objName, const char *_source, std::size_t _sourceSize,
+                     const LODMesh &_mesh );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief turn the cache on or off for every LODMesh load, it is on by default
+  /// @param[in] _enabled true to read and write caches
+  //----------------------------------------------------------------------------------------------------------------------
+  static void setEnabled( bool _enabled );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is the cache used
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool getEnabled();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief hash of a block of memory, 64 bit FNV-1a run over 8 byte words
+  /// @param[in] _data the data to hash
+  /// @param[in] _size the number of bytes
+  /// @returns the hash
+  //----------------------------------------------------------------------------------------------------------------------
+  static uint64_t hash( const char *_data, std::size_t _size );
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the size and modification time of a file
+  /// @param[in] _fname the file
+  /// @param[out] o_size the size in bytes
+  /// @param[out] o_time the modification time in seconds
+  /// @returns false if the file doesn't exist
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool getFileInfo( const std::string &_fname, uint64_t &o_size, int64_t &o_time );
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,641 @@
+#ifndef LODMESH_H_
+#define LODMESH_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODMesh.h
+/// @brief obj loader and LOD creator with no Qt, NGL or OpenGL dependencies. Used by ModelLODTri in the GUI
+///   and directly by lodgen-cli
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cmath>
+#include <stdlib.h>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "LODVec3.h"
+#include "WorkingMesh.h"
+#include "SmallVector.h"
+#include "CollapseHeap.h"
+#include "ProgressiveMesh.h"
+#include "ObjTokenizer.h"
+#include "Quadric.h"
+#include "LODStats.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the edge collapse costs createLOD can decimate with
+//----------------------------------------------------------------------------------------------------------------------
+enum LODCostMetric
+{
+  COST_MELAX,       ///< Melax's edge length x curvature, the collapsed vertex is moved onto its neighbour
+  COST_QEM,         ///< Garland-Heckbert quadric error, the collapsed vertex is moved onto its neighbour
+  COST_QEM_OPTIMAL  ///< quadric error with the kept vertex moved to the position with the least error
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief called by buildProgressiveMesh as the collapses go, from the thread doing the build. Gets the faces
+///   removed so far and the faces the whole decimation removes, returning false cancels the build. The first call
+///   is with 0 removed just before the first collapse, and the last, with both the same, as soon as the heap is
+///   empty
+//----------------------------------------------------------------------------------------------------------------------
+typedef std::function<bool (unsigned int _nRemoved, unsigned int _nTarget)> LODProgressCallback;
+
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the data parsed from one newline aligned piece of an obj file. Each chunk is parsed on its own thread
+///   then they are merged in file order. Face indices are already 0 based, except the ones that were negative
+///   (relative) in the file which are stored relative to the start of the chunk until the merge knows where
+///   the chunk starts
+//----------------------------------------------------------------------------------------------------------------------
+struct ObjChunk {
+  const char *m_begin; ///< first character of the chunk
+  const char *m_end; ///< one past the last character of the chunk
+  std::vector<LODVec3> m_verts; ///< the v lines in the chunk
+  std::vector<LODVec3> m_norm; ///< the vn lines in the chunk
+  std::vector<LODVec3> m_tex; ///< the vt lines in the chunk
+  std::vector<int> m_faceVert; ///< vertex index of each triangle corner
+  std::vector<int> m_faceNorm; ///< normal index of each triangle corner, -1 if missing
+  std::vector<int> m_faceTex; ///< texture coord index of each triangle corner, -1 if missing
+  std::vector<std::pair<unsigned int, unsigned char> > m_relative; ///< corners with chunk relative indices
+  LODVec3 m_bboxMin; ///< minimum of the chunk's vertices
+  LODVec3 m_bboxMax; ///< maximum of the chunk's vertices
+  double m_sum[3]; ///< sum of the chunk's vertices, in double so big meshes don't lose precision
+  unsigned int m_nLines; ///< number of lines in the chunk
+  std::vector<std::pair<unsigned int, std::string> > m_errors; ///< chunk line number and message of each error
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class LODMesh "core/include/LODMesh.h"
+/// @brief stores the vertex, normal, texture coord and triangle data of an obj mesh and creates LODs from it.
+///   Faces are stored as three flat index lists (vertex, normal and texture coord per corner, -1 if the face
+///   has none) so nothing here needs a GL context
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 split out of ModelLODTri
+//----------------------------------------------------------------------------------------------------------------------
+class LODMesh
+{
+
+public :
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor
+  //----------------------------------------------------------------------------------------------------------------------
+  LODMesh();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  constructor to load an objfile as a parameter
+  /// @param[in]  &_fname the name of the obj file to load
+  /// @param[in] _weldEpsilon see setWeldEpsilon, the default leaves the vertices as they are in the file
+  //----------------------------------------------------------------------------------------------------------------------
+  LODMesh( const std::string& _fname, float _weldEpsilon=-1.0f );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief LOD constructor, builds the mesh by replaying the base mesh's collapse record
+  /// @param[in] _base the mesh the progressive mesh record was built for
+  /// @param[in] _nCollapses the number of collapses to replay
+  //----------------------------------------------------------------------------------------------------------------------
+  LODMesh( const LODMesh &_base, unsigned int _nCollapses );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief deconstructor
+  //----------------------------------------------------------------------------------------------------------------------
+  ~LODMesh();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  Method to load the file in
+  /// @param[in]  _fname the name of the obj file to load
+  /// @returns true if the file was loaded
+  //----------------------------------------------------------------------------------------------------------------------
+  bool load( const std::string& _fname ) noexcept;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  method to save the obj
+  /// @param[in] _fname the name of the file to save
+  /// @param[in] _precision significant digits written for each float, 6 matches the old stream output and 0
+  ///   writes the shortest text that reads back as the same float
+  /// @returns true if the file was written
+  //----------------------------------------------------------------------------------------------------------------------
+  bool save( const std::string& _fname, unsigned int _precision=6 ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  method to create a LOD for the current mesh. The first call decimates the whole mesh once to build
+  ///   the progressive mesh record, after that every call only replays the record
+  /// @param[in] _nFaces the number of faces the LOD mesh will have
+  /// @param[in] _metric the edge collapse cost to decimate with, changing it rebuilds the record
+  /// @returns LODMesh* of the reduced mesh LOD with _nFaces, NULL if the progress callback cancelled the build
+  //----------------------------------------------------------------------------------------------------------------------
+  LODMesh* createLOD(const unsigned int _nFaces, LODCostMetric _metric=COST_MELAX );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  method to create a LOD for the current mesh with a target vertex count
+  /// @param[in] _nVerts the number of vertices the LOD mesh will be reduced to
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @returns LODMesh* of the reduced mesh LOD, NULL if the progress callback cancelled the build
+  //----------------------------------------------------------------------------------------------------------------------
+  LODMesh* createLODByVertices(const unsigned int _nVerts, LODCostMetric _metric=COST_MELAX );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  create a whole chain of LODs in one pass. The targets are visited from the most faces to the
+  ///   fewest and the collapse record is only walked once, each LOD is a snapshot taken as the walk crosses
+  ///   its target
+  /// @param[in] _nFaces the number of faces of each LOD, in any order
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @returns the LODs in the same order as _nFaces, the caller owns them. Empty if the build was cancelled
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<LODMesh*> createLODChain( const std::vector<unsigned int> &_nFaces,
+                                        LODCostMetric _metric=COST_MELAX );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  fully decimate a copy of the mesh and record every collapse in m_progressiveMesh. Called by
+  ///   createLOD the first time it is used or when it is asked for a different metric
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @returns false if the progress callback cancelled it, the mesh is then left with no record as it was
+  ///   before and can be built again
+  //----------------------------------------------------------------------------------------------------------------------
+  bool buildProgressiveMesh( LODCostMetric _metric=COST_MELAX );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set the function buildProgressiveMesh reports its progress to and checks for cancelling, eg. so a
+  ///   GUI can run createLOD on a worker thread. It is called before the first collapse, every few
+  ///   thousand faces removed and after the last collapse
+  /// @param[in] _progress the callback, an empty one turns the reporting off
+  //----------------------------------------------------------------------------------------------------------------------
+  void setProgressCallback( const LODProgressCallback &_progress ) {m_progress = _progress;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the metric the current collapse record was built with
+  //----------------------------------------------------------------------------------------------------------------------
+  LODCostMetric getCostMetric() const {return m_costMetric;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set how far the decimation may stray from strict cheapest first order so it can run on all the
+  ///   worker threads. Each round takes collapses whose 1-rings don't overlap from the cheapest _tolerance of
+  ///   the vertices left and applies them at once. The next createLOD rebuilds the record if it changed
+  /// @param[in] _tolerance fraction of the remaining vertices a round picks from, eg. 0.05. 0 (the default)
+  ///   collapses one vertex at a time in exact cost order
+  //----------------------------------------------------------------------------------------------------------------------
+  void setBatchTolerance( float _tolerance ) {m_batchTolerance = std::min(std::max(_tolerance, 0.0f), 1.0f);}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the batch decimation tolerance
+  //----------------------------------------------------------------------------------------------------------------------
+  float getBatchTolerance() const {return m_batchTolerance;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set if the one at a time Melax decimation updates costs lazily. After a collapse the neighbours'
+  ///   costs are only marked stale and worked out again when the vertex reaches the top of the heap, instead of
+  ///   straight away, which saves most of the cost evaluations. A stale cost that has really gone down is
+  ///   collapsed a little later than the exact order would, so the LODs differ slightly. The quadric metrics
+  ///   already only look at the edges into the kept vertex and the batch decimation updates its costs on the
+  ///   threads, so neither uses it. The next createLOD rebuilds the record if it changed
+  /// @param[in] _lazy true for lazy updates, false (the default) for the exact cheapest first order
+  //----------------------------------------------------------------------------------------------------------------------
+  void setLazyCosts( bool _lazy ) {m_lazyCosts = _lazy;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get if the costs are updated lazily
+  //----------------------------------------------------------------------------------------------------------------------
+  bool getLazyCosts() const {return m_lazyCosts;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set how close the vertices of the next load have to be to be welded into one. Exporters often write
+  ///   a copy of a position for every uv or normal seam it is on, the decimator would see each seam as an open
+  ///   boundary. Only the positions are merged, every corner keeps its own normal and texture coord, and faces
+  ///   left with two corners on one vertex are dropped. The cache remembers the epsilon it was made with
+  /// @param[in] _epsilon the largest distance between welded vertices, 0 for exact duplicates only and
+  ///   negative (the default) to load the vertices as they are
+  //----------------------------------------------------------------------------------------------------------------------
+  void setWeldEpsilon( float _epsilon ) {m_weldEpsilon = _epsilon < 0.0f ? -1.0f : _epsilon;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the weld epsilon, negative if the vertices aren't welded
+  //----------------------------------------------------------------------------------------------------------------------
+  float getWeldEpsilon() const {return m_weldEpsilon;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get how long the last buildProgressiveMesh took
+  /// @returns the time in milliseconds, 0 if the record hasn't been built
+  //----------------------------------------------------------------------------------------------------------------------
+  double getBuildTime() const {return m_buildTime;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get how long this LOD took to replay and extract from the collapse record of its base mesh
+  /// @returns the time in milliseconds, 0 for a mesh that was loaded
+  //----------------------------------------------------------------------------------------------------------------------
+  double getExtractTime() const {return m_extractTime;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get how long the last pass working out every vertex's collapse cost took, by load for the Melax
+  ///   costs or by buildProgressiveMesh for the quadric ones
+  /// @returns the time in milliseconds, 0 if the costs came from the cache
+  //----------------------------------------------------------------------------------------------------------------------
+  double getCostTime() const {return m_costTime;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the timings and counters of everything done to this mesh since it was loaded or made, or since
+  ///   resetStats. A LOD has its own, so add them to the base mesh's for a whole run. All zero without LOD_STATS
+  //----------------------------------------------------------------------------------------------------------------------
+  const LODStats& getStats() const {return m_stats;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set the stats back to zero
+  //----------------------------------------------------------------------------------------------------------------------
+  void resetStats() {m_stats.reset();}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get if loaded or not
+  /// returns bool of m_loaded
+  //----------------------------------------------------------------------------------------------------------------------
+  bool getLoaded() const {return m_loaded;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of vertices
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumVerts() const {return m_verts.size();}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of normals
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumNormals() const {return m_norm.size();}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of texture coords
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumTexCords() const {return m_tex.size();}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of triangles
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumFaces() const {return m_faceVert.size()/3;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the vertex positions
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<LODVec3>& getVerts() const {return m_verts;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the normals
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<LODVec3>& getNormals() const {return m_norm;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the texture coords
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<LODVec3>& getTexCords() const {return m_tex;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the vertex id of every triangle corner, three per face
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<int>& getFaceVerts() const {return m_faceVert;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the normal id of every triangle corner, -1 if the face has no normals
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<int>& getFaceNormals() const {return m_faceNorm;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the texture coord id of every triangle corner, -1 if the face has no texture coords
+  //----------------------------------------------------------------------------------------------------------------------
+  const std::vector<int>& getFaceTexCords() const {return m_faceTex;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the minimum corner of the bounding box, worked out while the mesh is built
+  //----------------------------------------------------------------------------------------------------------------------
+  const LODVec3& getBBoxMin() const {return m_bboxMin;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the maximum corner of the bounding box
+  //----------------------------------------------------------------------------------------------------------------------
+  const LODVec3& getBBoxMax() const {return m_bboxMax;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the average of all the vertex positions
+  //----------------------------------------------------------------------------------------------------------------------
+  const LODVec3& getCenter() const {return m_center;}
+
+protected :
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief parse the values of a v line and add the vertex
+  /// @param[in] _tok the tokenizer, just after the keyword
+  /// @param[in,out] io_chunk the chunk being parsed
+  //----------------------------------------------------------------------------------------------------------------------
+  static void parseVertex( ObjTokenizer &_tok, ObjChunk &io_chunk );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief parse the values of a vn line and add the normal
+  /// @param[in] _tok the tokenizer, just after the keyword
+  /// @param[in,out] io_chunk the chunk being parsed
+  //----------------------------------------------------------------------------------------------------------------------
+  static void parseNormal( ObjTokenizer &_tok, ObjChunk &io_chunk );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief parse the values of a vt line and add the texture coord
+  /// @param[in] _tok the tokenizer, just after the keyword
+  /// @param[in,out] io_chunk the chunk being parsed
+  //----------------------------------------------------------------------------------------------------------------------
+  static void parseTextureCoordinate( ObjTokenizer &_tok, ObjChunk &io_chunk );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief parse the corners of an f line. Polygons are split into a triangle fan
+  /// @param[in] _tok the tokenizer, just after the keyword
+  /// @param[in,out] io_chunk the chunk being parsed
+  //----------------------------------------------------------------------------------------------------------------------
+  static void parseFace( ObjTokenizer &_tok, ObjChunk &io_chunk );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief parse every line of a chunk, safe to run on several chunks at once
+  /// @param[in,out] io_chunk the chunk, m_begin and m_end must be set
+  //----------------------------------------------------------------------------------------------------------------------
+  static void parseChunk( ObjChunk &io_chunk );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief append the chunks to the mesh lists in order. The element offsets of each chunk come from a prefix
+  ///   sum of the chunk sizes so the copies, and the fixing of relative indices, run in parallel
+  /// @param[in] _chunks the parsed chunks in file order
+  //----------------------------------------------------------------------------------------------------------------------
+  void mergeChunks( const std::vector<ObjChunk> &_chunks );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief take some faces out of the three corner lists, keeping the order of the rest
+  /// @param[in] _remove 1 for each face to remove
+  //----------------------------------------------------------------------------------------------------------------------
+  void removeFaces( const std::vector<char> &_remove );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief merge the vertices within m_weldEpsilon of each other once the file is merged, see setWeldEpsilon.
+  ///   The bounds are worked out again if any were merged
+  //----------------------------------------------------------------------------------------------------------------------
+  void weldVertices();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add a vertex to the bounding box and center, called as each vertex is added so the bounds never
+  ///   need their own pass
+  /// @param[in] _v the vertex position
+  //----------------------------------------------------------------------------------------------------------------------
+  void growBounds( const LODVec3 &_v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief turn the summed positions into the center once all the vertices have been added
+  //----------------------------------------------------------------------------------------------------------------------
+  void finishBounds();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief release the working mesh, its arrays and rings all go in one go
+  //----------------------------------------------------------------------------------------------------------------------
+  void clearVtxTriDataOut();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief build the collapse cost heap from the costs of the working mesh
+  //----------------------------------------------------------------------------------------------------------------------
+  void storeCollapseCostList();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief clear collapse cost heap
+  //----------------------------------------------------------------------------------------------------------------------
+  void clearCollapseCostList();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  build the base adjacency lists (m_vertAdjStart, m_vertAdj, m_faceAdjStart and m_faceAdj) from the
+  ///   loaded face list
+  //----------------------------------------------------------------------------------------------------------------------
+  void buildAdjacency();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  make the working mesh in m_working straight from the base lists, in one parallel pass with no ids
+  ///   to remap. It starts with the Melax costs, which are worked out and kept in m_initialCost and
+  ///   m_initialCollapse the first time
+  //----------------------------------------------------------------------------------------------------------------------
+  void buildVtxTriData();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  calculate the cost of an edge collapse from two vertices
+  /// @param[in] _u vertex id, from this vertex collapse cost onto _v
+  /// @param[in] _v vertex id, collapse cost onto this vertex from _u
+  /// @returns float of the collapse cost from _u to _v
+  //----------------------------------------------------------------------------------------------------------------------
+  float calculateEColCost( int _u, int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  calculate the quadric error of collapsing _u onto _v, used instead of calculateEColCost for the
+  ///   QEM metrics
+  /// @param[in] _u vertex id, from this vertex collapse cost onto _v
+  /// @param[in] _v vertex id, collapse cost onto this vertex from _u
+  /// @param[out] o_pos where _v ends up after the collapse
+  /// @returns float of the collapse cost from _u to _v
+  //----------------------------------------------------------------------------------------------------------------------
+  float calculateQuadricCost( int _u, int _v, LODVec3 &o_pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  find where _v goes when _u is collapsed onto it and the quadric error there, without the flipped
+  ///   face check. Only reads the quadrics and positions of _u and _v
+  /// @param[in] _u vertex id, from this vertex collapse cost onto _v
+  /// @param[in] _v vertex id, collapse cost onto this vertex from _u
+  /// @param[out] o_pos where _v ends up after the collapse
+  /// @returns the quadric error at o_pos
+  //----------------------------------------------------------------------------------------------------------------------
+  double calculateQuadricPosition( int _u, int _v, LODVec3 &o_pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  check if moving _u to a position would turn over any of its faces that _v isn't part of
+  /// @param[in] _u the vertex being moved
+  /// @param[in] _v the vertex it is collapsing with
+  /// @param[in] _pos where _u moves to
+  /// @returns true if a face would end up facing the other way
+  //----------------------------------------------------------------------------------------------------------------------
+  bool flipsFace( int _u, int _v, const LODVec3 &_pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  sum the plane quadric of every face around each working vertex into m_quadrics, plus a plane
+  ///   at right angles to the face along every boundary edge so open edges aren't eaten away. Runs on the
+  ///   worker threads
+  //----------------------------------------------------------------------------------------------------------------------
+  void calculateQuadrics();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  find the cheapest collapse from selected vertex and store it on the vertex. Only _v is written so
+  ///   this can be called for different vertices from several threads at once
+  /// @param[in] _v vertex id from which all collapse costs will be calculated
+  //----------------------------------------------------------------------------------------------------------------------
+  void findEColCostAtVtx( int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  calculate the cost of all adjacent vertex collapses from selected vertex. If _v is in the
+  ///   collapse cost heap its entry is moved to match the new cost
+  /// @param[in] _v vertex id from which all collapse costs will be calculated
+  //----------------------------------------------------------------------------------------------------------------------
+  void calculateEColCostAtVtx( int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  calculate the edge collapse costs of every working vertex, split over the worker threads. The
+  ///   collapse cost heap is not touched, it is built from the results afterwards by storeCollapseCostList
+  //----------------------------------------------------------------------------------------------------------------------
+  void calculateAllEColCosts();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the bytes reserved by the mesh and adjacency lists, for the stats
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long getListBytes() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the bytes allocated so far for the working mesh, for the stats
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long getWorkingBytes() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  collapse the edge between two vertices and add the faces it touches to the current collapse
+  ///   record. Use vertices of m_working!
+  /// @param[in] _u vertex id, from this vertex collapse onto _v
+  /// @param[in] _v vertex id, collapse onto this vertex from _u
+  //----------------------------------------------------------------------------------------------------------------------
+  void collapseEdge( int _u, int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  the part of collapseEdge that changes the mesh: removes the faces on the edge, moves the rest of
+  ///   _u's faces onto _v and deletes _u, without touching any costs. Only _u, its neighbours and its faces are
+  ///   written so collapses with separate 1-rings can run on different threads
+  /// @param[in] _u vertex id, from this vertex collapse onto _v
+  /// @param[in] _v vertex id, collapse onto this vertex from _u, -1 if _u has no neighbours
+  /// @param[in,out] io_record the collapse is recorded at the end of this
+  /// @returns the number of faces removed
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int applyCollapse( int _u, int _v, ProgressiveMesh &io_record );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  decimate everything left in the collapse cost heap in rounds of independent collapses, see
+  ///   setBatchTolerance
+  /// @returns false if the progress callback cancelled it
+  //----------------------------------------------------------------------------------------------------------------------
+  bool decimateInBatches();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  pass m_nDeletedFaces to the progress callback if enough faces have gone since it was last called
+  /// @param[in,out] io_nReported the faces removed when it was last called, updated when it is called again
+  /// @returns false if the callback asked to cancel
+  //----------------------------------------------------------------------------------------------------------------------
+  bool reportProgress( unsigned int &io_nReported );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  check the collapse record can be used for a LOD
+  /// @param[in] _metric the metric the LOD is wanted with
+  /// @returns true if the record was built with _metric and the current batch tolerance and lazy cost setting
+  //----------------------------------------------------------------------------------------------------------------------
+  bool isRecordCurrent( LODCostMetric _metric ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief  fix up the QEM costs after a vertex was collapsed onto _v. _v and every old neighbour of either
+  ///   vertex has all its edges looked at again, as the Melax costs are. Only the quadric of _v changed, but
+  ///   the flipped face penalty of any edge of a neighbour can change with the faces that moved onto _v
+  /// @param[in] _v the vertex the deleted vertex was collapsed onto
+  /// @param[in] _uAdj the neighbours the deleted vertex had before the collapse
+  //----------------------------------------------------------------------------------------------------------------------
+  void updateQuadricCosts( int _v, const std::vector<int> &_uAdj );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief fill this (empty) mesh with the faces left alive in a replay of _base's collapse record,
+  ///   renumbering the vertices, normals and texture coords so only the used ones are kept. The three streams
+  ///   are independent so they are renumbered on separate threads
+  /// @param[in] _base the mesh the collapse record was built for
+  /// @param[in] _verts the position of every base vertex, after replayPositions if the record moved them
+  /// @param[in] _faceVerts the replayed vertex ids of every base face
+  /// @param[in] _faceAlive 1 for every base face still in the mesh
+  /// @param[in] _nFaces the number of faces alive, used to reserve the lists
+  //----------------------------------------------------------------------------------------------------------------------
+  void extractReplay( const LODMesh &_base, const std::vector<LODVec3> &_verts, const std::vector<int> &_faceVerts,
+                      const std::vector<char> &_faceAlive, unsigned int _nFaces );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the vertex positions
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<LODVec3> m_verts;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the normals
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<LODVec3> m_norm;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the texture coords
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<LODVec3> m_tex;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief vertex id of each triangle corner, three per face
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_faceVert;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief normal id of each triangle corner, -1 if the face has no normals
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_faceNorm;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief texture coord id of each triangle corner, -1 if the face has no texture coords
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_faceTex;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief true if the mesh loaded
+  //----------------------------------------------------------------------------------------------------------------------
+  bool m_loaded;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief start of each vertex's adjacent vertices in m_vertAdj, with one extra at the end
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<unsigned int> m_vertAdjStart;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the adjacent vertex ids of every vertex, one after another
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<unsigned int> m_vertAdj;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief start of each vertex's adjacent faces in m_faceAdj, with one extra at the end
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<unsigned int> m_faceAdjStart;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the adjacent face ids of every vertex, one after another
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<unsigned int> m_faceAdj;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief Melax collapse cost of each vertex of the base mesh, empty until they are first worked out
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<float> m_initialCost;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the vertex each vertex of the base mesh collapses onto for m_initialCost, -1 for none
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_initialCollapse;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the working copy that is decimated while building the progressive mesh, built from the base lists by
+  ///   buildVtxTriData and only kept while it is needed
+  //----------------------------------------------------------------------------------------------------------------------
+  WorkingMesh m_working;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the neighbours of the vertex collapseEdge is removing, kept between collapses so its room is reused
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_ringScratch;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief indexed heap of the working vertex ids ordered by collapse cost, cheapest first
+  //----------------------------------------------------------------------------------------------------------------------
+  CollapseHeap m_lodVertexCollapseCost;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the error quadric of each working vertex, by ID. Only filled while building the progressive mesh
+  ///   with a QEM metric
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<Quadric> m_quadrics;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the metric used by the costs being calculated and by the current collapse record
+  //----------------------------------------------------------------------------------------------------------------------
+  LODCostMetric m_costMetric;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief fraction of the remaining vertices each batch decimation round picks from, 0 for one at a time
+  //----------------------------------------------------------------------------------------------------------------------
+  float m_batchTolerance;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the batch tolerance the current collapse record was built with
+  //----------------------------------------------------------------------------------------------------------------------
+  float m_recordTolerance;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief see setLazyCosts
+  //----------------------------------------------------------------------------------------------------------------------
+  bool m_lazyCosts;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the lazy cost setting the current collapse record was built with
+  //----------------------------------------------------------------------------------------------------------------------
+  bool m_recordLazy;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief see setWeldEpsilon
+  //----------------------------------------------------------------------------------------------------------------------
+  float m_weldEpsilon;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief stores current number of deleted faces while building the progressive mesh
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nDeletedFaces;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the ordered collapse record every LOD is extracted from
+  //----------------------------------------------------------------------------------------------------------------------
+  ProgressiveMesh m_progressiveMesh;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief minimum corner of the bounding box
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 m_bboxMin;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief maximum corner of the bounding box
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 m_bboxMax;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief average vertex position
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 m_center;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief running sum of the vertex positions while the mesh is being built, in double so big meshes don't
+  ///   lose precision
+  //----------------------------------------------------------------------------------------------------------------------
+  double m_boundSum[3];
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief number of vertices added to the bounds so far
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nBoundVerts;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief milliseconds the last buildProgressiveMesh took
+  //----------------------------------------------------------------------------------------------------------------------
+  double m_buildTime;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief milliseconds this LOD took to extract
+  //----------------------------------------------------------------------------------------------------------------------
+  double m_extractTime;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief milliseconds the last calculateAllEColCosts took
+  //----------------------------------------------------------------------------------------------------------------------
+  double m_costTime;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief see getStats, mutable so the const save can add its time
+  //----------------------------------------------------------------------------------------------------------------------
+  mutable LODStats m_stats;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief see setProgressCallback
+  //----------------------------------------------------------------------------------------------------------------------
+  LODProgressCallback m_progress;
+
+private :
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the cache reads and writes the mesh lists and initial costs directly
+  //----------------------------------------------------------------------------------------------------------------------
+  friend class LODCache;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the working mesh can't be copied so neither can this, use createLOD
+  //----------------------------------------------------------------------------------------------------------------------
+  LODMesh( const LODMesh & );
+  LODMesh& operator=( const LODMesh & );
+};
+
+
+
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
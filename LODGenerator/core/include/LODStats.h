@@ -0,0 +1,81 @@
+#ifndef LODSTATS_H_
+#define LODSTATS_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODStats.h
+/// @brief per phase timings and counters gathered by LODMesh, built in when LOD_STATS is defined (LODCore.pri
+///   defines it). Without it the struct is still there but stays zero and none of the collection is compiled
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief wraps a statement that only gathers stats so it is compiled out without LOD_STATS
+//----------------------------------------------------------------------------------------------------------------------
+#if defined(LOD_STATS)
+#define LOD_STAT(...) __VA_ARGS__
+#else
+#define LOD_STAT(...)
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief what a LODMesh has done since it was loaded or made, every field adds up over the operations so the
+///   stats of a base mesh and its LODs can be added together for a whole run. Times are in milliseconds
+//----------------------------------------------------------------------------------------------------------------------
+struct LODStats {
+  double m_parseMs; ///< reading the obj and welding its vertices, or reading its cache
+  double m_adjacencyMs; ///< building the adjacency lists and the working mesh
+  double m_costMs; ///< working out every vertex's collapse cost, the first pass and any quadric pass
+  double m_collapseMs; ///< the collapse loops of buildProgressiveMesh, with the heap build and cost updates
+  double m_extractMs; ///< replaying the collapse record into a LOD
+  double m_saveMs; ///< writing the obj
+  unsigned long long m_costEvaluations; ///< edge collapse costs worked out
+  unsigned long long m_collapses; ///< edge collapses applied
+  unsigned long long m_heapOperations; ///< pushes, updates and removals of the collapse cost heap
+  unsigned long long m_facesDeleted; ///< faces removed by the collapses
+  unsigned long long m_bytesAllocated; ///< bytes of mesh lists and working mesh arrays and rings allocated
+
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief constructor, everything starts at 0
+  //----------------------------------------------------------------------------------------------------------------------
+  LODStats() { reset(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set everything back to 0
+  //----------------------------------------------------------------------------------------------------------------------
+  void reset();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add another set of stats to these, eg. a LOD's to its base mesh's
+  /// @param[in] _stats the stats to add
+  //----------------------------------------------------------------------------------------------------------------------
+  void add( const LODStats &_stats );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the rate the collapse loops removed faces at
+  /// @returns faces per second, 0 if nothing was collapsed
+  //----------------------------------------------------------------------------------------------------------------------
+  double getFacesDeletedPerSecond() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the stats as a JSON object
+  /// @returns the object text, one field per line
+  //----------------------------------------------------------------------------------------------------------------------
+  std::string toJSON() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief write toJSON to a file
+  /// @param[in] _fname the file to write
+  /// @returns true if the file was written
+  //----------------------------------------------------------------------------------------------------------------------
+  bool writeJSON( const std::string &_fname ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is the collection compiled in
+  /// @returns true if LOD_STATS was defined
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool getEnabled()
+  {
+#if defined(LOD_STATS)
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+#ifndef LODVEC3_H_
+#define LODVEC3_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODVec3.h
+/// @brief minimal 3 float vector used by the LOD core so it doesn't need NGL (and with it a GL context)
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class LODVec3 "core/include/LODVec3.h"
+/// @brief simple x,y,z vector with the handful of operations the decimator needs. Laid out like ngl::Vec3 so the
+///   GUI can copy it straight across
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 split out of ModelLODTri for the headless core
+//----------------------------------------------------------------------------------------------------------------------
+class LODVec3
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, sets the vector to 0,0,0
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3():
+    m_x(0.0f),
+    m_y(0.0f),
+    m_z(0.0f){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief value constructor
+  /// @param[in] _x the x value
+  /// @param[in] _y the y value
+  /// @param[in] _z the z value
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3( float _x, float _y, float _z ):
+    m_x(_x),
+    m_y(_y),
+    m_z(_z){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief subtract two vectors
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 operator-( const LODVec3 &_v ) const { return LODVec3(m_x-_v.m_x, m_y-_v.m_y, m_z-_v.m_z); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add two vectors
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 operator+( const LODVec3 &_v ) const { return LODVec3(m_x+_v.m_x, m_y+_v.m_y, m_z+_v.m_z); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief scale the vector
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 operator*( float _s ) const { return LODVec3(m_x*_s, m_y*_s, m_z*_s); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief dot product
+  /// @param[in] _v the other vector
+  /// @returns the dot product of this and _v
+  //----------------------------------------------------------------------------------------------------------------------
+  float dot( const LODVec3 &_v ) const { return m_x*_v.m_x + m_y*_v.m_y + m_z*_v.m_z; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief cross product
+  /// @param[in] _v the other vector
+  /// @returns this x _v
+  //----------------------------------------------------------------------------------------------------------------------
+  LODVec3 cross( const LODVec3 &_v ) const
+  {
+    return LODVec3(m_y*_v.m_z - m_z*_v.m_y,
+                   m_z*_v.m_x - m_x*_v.m_z,
+                   m_x*_v.m_y - m_y*_v.m_x);
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief length of the vector
+  //----------------------------------------------------------------------------------------------------------------------
+  float length() const { return std::sqrt(dot(*this)); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief normalize the vector in place, zero length vectors are left alone
+  //----------------------------------------------------------------------------------------------------------------------
+  void normalize()
+  {
+    float len = length();
+    if (len != 0.0f)
+    {
+      m_x /= len;
+      m_y /= len;
+      m_z /= len;
+    }
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief x component
+  //----------------------------------------------------------------------------------------------------------------------
+  float m_x;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief y component
+  //----------------------------------------------------------------------------------------------------------------------
+  float m_y;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief z component
+  //----------------------------------------------------------------------------------------------------------------------
+  float m_z;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
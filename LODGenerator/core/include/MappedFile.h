@@ -0,0 +1,82 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file MappedFile.h
+/// @brief read only memory map of a whole file, used by the obj loader so it can scan the file in place
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <cstddef>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class MappedFile "core/include/MappedFile.h"
+/// @brief maps a file into memory read only for the lifetime of the object. Uses mmap on unix and a file mapping
+///   on windows, the data is not null terminated so always use getData() with getSize()
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 added for the pointer based obj loader
+//----------------------------------------------------------------------------------------------------------------------
+class MappedFile
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, nothing is mapped
+  //----------------------------------------------------------------------------------------------------------------------
+  MappedFile();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief unmaps the file
+  //----------------------------------------------------------------------------------------------------------------------
+  ~MappedFile();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief map a file, anything already mapped is closed first
+  /// @param[in] _fname the file to map
+  /// @returns true if the file could be opened, an empty file is opened but has no data
+  //----------------------------------------------------------------------------------------------------------------------
+  bool open( const std::string &_fname );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief unmap the file
+  //----------------------------------------------------------------------------------------------------------------------
+  void close();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is a file open
+  //----------------------------------------------------------------------------------------------------------------------
+  bool isOpen() const { return m_open; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the start of the file data
+  //----------------------------------------------------------------------------------------------------------------------
+  const char* getData() const { return m_data; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the size of the file in bytes
+  //----------------------------------------------------------------------------------------------------------------------
+  std::size_t getSize() const { return m_size; }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief start of the mapped data, NULL if the file is empty or not open
+  //----------------------------------------------------------------------------------------------------------------------
+  const char *m_data;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief size of the mapped data
+  //----------------------------------------------------------------------------------------------------------------------
+  std::size_t m_size;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief true once a file has been opened
+  //----------------------------------------------------------------------------------------------------------------------
+  bool m_open;
+#ifdef _WIN32
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief windows file and mapping handles
+  //----------------------------------------------------------------------------------------------------------------------
+  void *m_file;
+  void *m_mapping;
+#endif
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the mapping can't be shared so the class can't be copied
+  //----------------------------------------------------------------------------------------------------------------------
+  MappedFile( const MappedFile & );
+  MappedFile& operator=( const MappedFile & );
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,260 @@
+#ifndef OBJTOKENIZER_H_
+#define OBJTOKENIZER_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ObjTokenizer.h
+/// @brief pointer based tokenizer for obj text, no allocation and no copies of the input
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <cmath>
+#include <stdint.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class ObjTokenizer "core/include/ObjTokenizer.h"
+/// @brief walks a [begin, end) character range, such as a MappedFile, reading obj keywords, floats and ints in
+///   place. The input doesn't need to be null terminated. Numbers are parsed like std::from_chars, there is no
+///   locale and nothing is allocated, so the loader runs at close to the speed the file can be read.
+///   Everything is inline as it is called for every token of the file
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 replaces the boost::spirit classic grammar in the loader
+//----------------------------------------------------------------------------------------------------------------------
+class ObjTokenizer
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief constructor
+  /// @param[in] _begin the first character to read
+  /// @param[in] _end one past the last character to read
+  //----------------------------------------------------------------------------------------------------------------------
+  ObjTokenizer( const char *_begin, const char *_end ):
+    m_cur(_begin),
+    m_end(_end){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief has all the input been read
+  //----------------------------------------------------------------------------------------------------------------------
+  bool atEnd() const { return m_cur >= m_end; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is the next character the end of the line (or the input)
+  //----------------------------------------------------------------------------------------------------------------------
+  bool atLineEnd() const { return m_cur >= m_end || *m_cur == '\n' || *m_cur == '\r'; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief skip spaces and tabs, stops at the end of the line
+  //----------------------------------------------------------------------------------------------------------------------
+  void skipSpace()
+  {
+    while (m_cur < m_end && (*m_cur == ' ' || *m_cur == '\t'))
+    {
+      ++m_cur;
+    }
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move to the start of the next line
+  //----------------------------------------------------------------------------------------------------------------------
+  void skipLine()
+  {
+    while (m_cur < m_end && *m_cur != '\n')
+    {
+      ++m_cur;
+    }
+    if (m_cur < m_end)
+    {
+      ++m_cur;
+    }
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief read a keyword that must be followed by a space or tab, eg "v" doesn't match "vt"
+  /// @param[in] _word the null terminated keyword
+  /// @returns true and moves past the keyword if it matched, otherwise nothing is read
+  //----------------------------------------------------------------------------------------------------------------------
+  bool matchKeyword( const char *_word )
+  {
+    const char *p = m_cur;
+    while (*_word != '\0')
+    {
+      if (p >= m_end || *p != *_word)
+      {
+        return false;
+      }
+      ++p;
+      ++_word;
+    }
+    if (p < m_end && *p != ' ' && *p != '\t')
+    {
+      return false;
+    }
+    m_cur = p;
+    return true;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief read a single character if it is the next one, whitespace is not skipped
+  /// @param[in] _c the character wanted
+  /// @returns true if it was read
+  //----------------------------------------------------------------------------------------------------------------------
+  bool consume( char _c )
+  {
+    if (m_cur < m_end && *m_cur == _c)
+    {
+      ++m_cur;
+      return true;
+    }
+    return false;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is the next character _c, nothing is read
+  //----------------------------------------------------------------------------------------------------------------------
+  bool peek( char _c ) const { return m_cur < m_end && *m_cur == _c; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief read a signed int after skipping spaces
+  /// @param[out] o_value the value read
+  /// @returns false if there was no number, nothing is read
+  //----------------------------------------------------------------------------------------------------------------------
+  bool parseInt( int &o_value )
+  {
+    skipSpace();
+    const char *p = m_cur;
+    bool negative = false;
+    if (p < m_end && (*p == '-' || *p == '+'))
+    {
+      negative = (*p == '-');
+      ++p;
+    }
+    const char *digits = p;
+    int value = 0;
+    while (p < m_end && isDigit(*p))
+    {
+      value = value*10 + (*p - '0');
+      ++p;
+    }
+    if (p == digits)
+    {
+      return false;
+    }
+    o_value = negative ? -value : value;
+    m_cur = p;
+    return true;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief read a float after skipping spaces, accepts [+-]digits[.digits][(e|E)[+-]digits]. Up to 19
+  ///   significant digits are kept in an integer and scaled once in double precision so the result is the
+  ///   correctly rounded float for anything an exporter writes
+  /// @param[out] o_value the value read
+  /// @returns false if there was no number, nothing is read
+  //----------------------------------------------------------------------------------------------------------------------
+  bool parseFloat( float &o_value )
+  {
+    skipSpace();
+    const char *p = m_cur;
+    bool negative = false;
+    if (p < m_end && (*p == '-' || *p == '+'))
+    {
+      negative = (*p == '-');
+      ++p;
+    }
+    uint64_t mantissa = 0;
+    int nDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+    // integer part, digits past what fits in the mantissa only move the exponent
+    while (p < m_end && isDigit(*p))
+    {
+      if (nDigits < 19)
+      {
+        mantissa = mantissa*10 + (*p - '0');
+        nDigits += (mantissa != 0);
+      }
+      else
+      {
+        ++exponent;
+      }
+      anyDigits = true;
+      ++p;
+    }
+    // fraction part
+    if (p < m_end && *p == '.')
+    {
+      ++p;
+      while (p < m_end && isDigit(*p))
+      {
+        if (nDigits < 19)
+        {
+          mantissa = mantissa*10 + (*p - '0');
+          nDigits += (mantissa != 0);
+          --exponent;
+        }
+        anyDigits = true;
+        ++p;
+      }
+    }
+    if (!anyDigits)
+    {
+      return false;
+    }
+    // exponent, only read if there are digits after the e
+    if (p < m_end && (*p == 'e' || *p == 'E'))
+    {
+      const char *e = p+1;
+      bool negativeExp = false;
+      if (e < m_end && (*e == '-' || *e == '+'))
+      {
+        negativeExp = (*e == '-');
+        ++e;
+      }
+      if (e < m_end && isDigit(*e))
+      {
+        int exp = 0;
+        while (e < m_end && isDigit(*e))
+        {
+          if (exp < 10000)
+          {
+            exp = exp*10 + (*e - '0');
+          }
+          ++e;
+        }
+        exponent += negativeExp ? -exp : exp;
+        p = e;
+      }
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (mantissa != 0 && exponent != 0)
+    {
+      // powers of ten up to 22 are exact in a double
+      static const double s_pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+      if (exponent < 0 && exponent >= -22)
+      {
+        value /= s_pow10[-exponent];
+      }
+      else if (exponent > 0 && exponent <= 22)
+      {
+        value *= s_pow10[exponent];
+      }
+      else
+      {
+        value *= std::pow(10.0, exponent);
+      }
+    }
+    o_value = static_cast<float>(negative ? -value : value);
+    m_cur = p;
+    return true;
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is _c 0-9
+  //----------------------------------------------------------------------------------------------------------------------
+  static bool isDigit( char _c ) { return static_cast<unsigned char>(_c - '0') < 10; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the next character to read
+  //----------------------------------------------------------------------------------------------------------------------
+  const char *m_cur;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief one past the last character
+  //----------------------------------------------------------------------------------------------------------------------
+  const char *m_end;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
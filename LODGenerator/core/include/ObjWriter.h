@@ -0,0 +1,90 @@
+#ifndef OBJWRITER_H_
+#define OBJWRITER_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ObjWriter.h
+/// @brief buffered obj writer that formats the numbers on the worker threads, used by LODMesh::save
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "LODVec3.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class ObjWriter "core/include/ObjWriter.h"
+/// @brief writes the blocks of an obj file (v, vt, vn and f lines). Each block is split into chunks of lines
+///   that are formatted straight into character buffers in parallel, std::to_chars where the standard library
+///   has it, then written in order with one write call per chunk. Nothing is flushed until the file is closed
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 replaces the fstream operator<< save
+//----------------------------------------------------------------------------------------------------------------------
+class ObjWriter
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief constructor, no file is open
+  /// @param[in] _precision significant digits of each float, as printf %g. 0 writes the shortest text that reads
+  ///   back as exactly the same float
+  //----------------------------------------------------------------------------------------------------------------------
+  ObjWriter( unsigned int _precision=6 );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief open a file for writing, it is truncated
+  /// @param[in] _fname the file to write
+  /// @returns true if the file could be opened
+  //----------------------------------------------------------------------------------------------------------------------
+  bool open( const std::string &_fname );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief flush and close the file
+  /// @returns true if everything was written
+  //----------------------------------------------------------------------------------------------------------------------
+  bool close();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief write a line of text as it is, eg. a comment
+  /// @param[in] _line the line without its newline
+  //----------------------------------------------------------------------------------------------------------------------
+  void writeLine( const std::string &_line );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief write a line per vector, eg. "v x y z"
+  /// @param[in] _prefix the line start, eg. "v "
+  /// @param[in] _values the vectors
+  /// @param[in] _nComponents how many of x, y and z to write, 2 for texture coords
+  //----------------------------------------------------------------------------------------------------------------------
+  void writeVec3Block( const char *_prefix, const std::vector<LODVec3> &_values, unsigned int _nComponents );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief write an f line per triangle with v, v//n, v/t or v/t/n for each corner
+  /// @param[in] _faceVert vertex id of every corner
+  /// @param[in] _faceTex texture coord id of every corner, -1 for none
+  /// @param[in] _faceNorm normal id of every corner, -1 for none
+  //----------------------------------------------------------------------------------------------------------------------
+  void writeFaceBlock( const std::vector<int> &_faceVert, const std::vector<int> &_faceTex,
+                       const std::vector<int> &_faceNorm );
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief format _n lines in chunks on the worker threads and write the chunks in order
+  /// @param[in] _n the number of lines
+  /// @param[in] _maxLine the most characters one line can take
+  /// @param[in] _format writes line i at a char pointer and returns the end of it
+  //----------------------------------------------------------------------------------------------------------------------
+  template <typename Format>
+  void writeBlock( unsigned int _n, unsigned int _maxLine, Format _format );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the file being written
+  //----------------------------------------------------------------------------------------------------------------------
+  std::ofstream m_file;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief significant digits of each float, 0 for the shortest round trip
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_precision;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief one buffer per chunk, kept between blocks so they are only allocated once
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<std::vector<char> > m_buffers;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+#ifndef PARALLELFOR_H_
+#define PARALLELFOR_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ParallelFor.h
+/// @brief splits a loop over std::threads, used by the loader and the decimator for their data parallel passes
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the number of threads parallelFor will use at most
+/// @returns the value set by setNumWorkerThreads, or the number of hardware threads if it wasn't set
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int getNumWorkerThreads();
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief set the number of threads parallelFor will use at most, eg. lodgen-cli lowers it when it is already
+///   processing several files at once
+/// @param[in] _nThreads the number of threads, 0 goes back to the number of hardware threads
+//----------------------------------------------------------------------------------------------------------------------
+void setNumWorkerThreads( unsigned int _nThreads );
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief run _func over [_begin, _end) split into one contiguous range per thread. The calling thread does the
+///   first range and waits for the rest, so everything written by _func can be used once this returns
+/// @param[in] _begin the first index
+/// @param[in] _end one past the last index
+/// @param[in] _minPerThread the smallest range worth giving a thread, small loops just run on the caller
+/// @param[in] _func called as _func(rangeBegin, rangeEnd), must be safe to call from several threads at once
+//----------------------------------------------------------------------------------------------------------------------
+template <typename Func>
+void parallelFor( unsigned int _begin, unsigned int _end, unsigned int _minPerThread, Func _func )
+{
+  if (_end <= _begin)
+  {
+    return;
+  }
+  unsigned int n = _end - _begin;
+  unsigned int nThreads = std::min(getNumWorkerThreads(), std::max(1u, n/std::max(1u, _minPerThread)));
+  if (nThreads <= 1)
+  {
+    _func(_begin, _end);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads-1);
+  for (unsigned int t=1; t<nThreads; ++t)
+  {
+    unsigned int rangeBegin = _begin + (unsigned int)((unsigned long long)n*t/nThreads);
+    unsigned int rangeEnd = _begin + (unsigned int)((unsigned long long)n*(t+1)/nThreads);
+    threads.push_back(std::thread(_func, rangeBegin, rangeEnd));
+  }
+  _func(_begin, _begin + (unsigned int)((unsigned long long)n/nThreads));
+  for (unsigned int t=0; t<threads.size(); ++t)
+  {
+    threads[t].join();
+  }
+}
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
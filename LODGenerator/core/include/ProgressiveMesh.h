@@ -0,0 +1,191 @@
+#ifndef PROGRESSIVEMESH_H_
+#define PROGRESSIVEMESH_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ProgressiveMesh.h
+/// @brief ordered log of edge collapses so any LOD can be extracted from the base mesh without re-decimating
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "LODVec3.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief a single edge collapse u -> v and the faces it touched. The face ids are stored packed in
+///   ProgressiveMesh, removed faces in [m_removedBegin, m_changedBegin) and faces that had u replaced by v
+///   in [m_changedBegin, m_changedEnd)
+//----------------------------------------------------------------------------------------------------------------------
+struct CollapseRecord {
+  int m_u; ///< the vertex removed by the collapse
+  int m_v; ///< the vertex u was collapsed onto, -1 if u had no neighbours
+  unsigned int m_removedBegin; ///< start of the removed face ids
+  unsigned int m_changedBegin; ///< start of the changed face ids, also the end of the removed ones
+  unsigned int m_changedEnd; ///< end of the changed face ids
+  unsigned int m_nFaces; ///< number of faces left in the mesh after this collapse
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class ProgressiveMesh "core/include/ProgressiveMesh.h"
+/// @brief stores the base triangle vertex ids and the full ordered list of collapses from one complete
+///   decimation (similar to Hoppe's progressive meshes). Replaying a prefix of the records over the base faces
+///   gives the face list of any LOD in linear time.
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 completed a working version of the class
+//----------------------------------------------------------------------------------------------------------------------
+class ProgressiveMesh
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, creates an empty record
+  //----------------------------------------------------------------------------------------------------------------------
+  ProgressiveMesh():
+    m_nBaseVerts(0),
+    m_built(false){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief clear all the records and the base faces
+  //----------------------------------------------------------------------------------------------------------------------
+  void clear();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set the base mesh the records are replayed over
+  /// @param[in] _faceVerts the three vertex ids of each base triangle
+  /// @param[in] _nVerts the number of vertices in the base mesh
+  /// @param[in] _positions true if the collapses will set their positions, see reserve
+  //----------------------------------------------------------------------------------------------------------------------
+  void setBaseMesh( const std::vector<int> &_faceVerts, unsigned int _nVerts, bool _positions=false );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief make room for a number of collapses and the faces they usually touch, so recording them doesn't
+  ///   allocate
+  /// @param[in] _nCollapses the number of collapses
+  /// @param[in] _positions true to make room for their positions too, otherwise the first setCollapsePosition
+  ///   does
+  //----------------------------------------------------------------------------------------------------------------------
+  void reserve( unsigned int _nCollapses, bool _positions=false );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief start recording a new collapse, faces added after this belong to it
+  /// @param[in] _u the vertex being removed
+  /// @param[in] _v the vertex u is collapsed onto, -1 if there isn't one
+  //----------------------------------------------------------------------------------------------------------------------
+  void beginCollapse( int _u, int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add a face removed by the current collapse. All removed faces must be added before changed ones
+  /// @param[in] _face the id of the removed face
+  //----------------------------------------------------------------------------------------------------------------------
+  void addRemovedFace( int _face );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add a face that had u replaced by v in the current collapse
+  /// @param[in] _face the id of the changed face
+  //----------------------------------------------------------------------------------------------------------------------
+  void addChangedFace( int _face );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set where v was moved to by the current collapse. Only used when the cost metric places the
+  ///   collapsed vertex, then it must be called for every collapse
+  /// @param[in] _pos the new position of v
+  //----------------------------------------------------------------------------------------------------------------------
+  void setCollapsePosition( const LODVec3 &_pos );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief finish the current collapse
+  /// @param[in] _nFaces the number of faces left in the mesh after the collapse
+  //----------------------------------------------------------------------------------------------------------------------
+  void endCollapse( unsigned int _nFaces );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add the collapses recorded in another ProgressiveMesh after the ones in this. Used by the batch
+  ///   decimation where each thread records its collapses separately, the face counts are worked out again
+  ///   here from the number of faces each collapse removed
+  /// @param[in] _batch the collapses to add, it doesn't need a base mesh
+  //----------------------------------------------------------------------------------------------------------------------
+  void append( const ProgressiveMesh &_batch );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of recorded collapses
+  /// @returns the number of collapses in the record
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumCollapses() const { return m_records.size(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of faces in the base mesh
+  /// @returns the number of base faces
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumBaseFaces() const { return m_baseFaceVerts.size()/3; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief has a decimation been recorded
+  /// @returns true if setBaseMesh has been called
+  //----------------------------------------------------------------------------------------------------------------------
+  bool isBuilt() const { return m_built; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief do the collapses move vertices
+  /// @returns true if a position was recorded for the collapses, the LODs then need replayPositions
+  //----------------------------------------------------------------------------------------------------------------------
+  bool hasPositions() const { return !m_positions.empty(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief find how many collapses are needed to get down to a face count, uses a binary search
+  /// @param[in] _nFaces the wanted number of faces
+  /// @returns the smallest number of collapses leaving _nFaces or fewer, or all of them if it can't be reached
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int collapsesForFaces( unsigned int _nFaces ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief find how many collapses are needed to get down to a vertex count, every collapse removes one vertex
+  /// @param[in] _nVerts the wanted number of vertices
+  /// @returns the number of collapses to replay
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int collapsesForVerts( unsigned int _nVerts ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of faces left after a number of collapses
+  /// @param[in] _nCollapses the number of collapses
+  /// @returns the face count
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int facesAfter( unsigned int _nCollapses ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief replay the first _nCollapses records over the base faces
+  /// @param[in] _nCollapses the number of records to replay
+  /// @param[out] o_faceVerts the three vertex ids of every base face after the collapses
+  /// @param[out] o_faceAlive 1 for every face that is still in the mesh, 0 if it was removed
+  //----------------------------------------------------------------------------------------------------------------------
+  void replay( unsigned int _nCollapses, std::vector<int> &o_faceVerts, std::vector<char> &o_faceAlive ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief carry on a replay, applying records [_from, _to) to faces that already have the first _from applied.
+  ///   Used to walk down a LOD chain in one pass instead of starting each LOD from the base faces
+  /// @param[in] _from the number of records already applied to the faces
+  /// @param[in] _to the number of records the faces should have applied after the call
+  /// @param[in,out] io_faceVerts the three vertex ids of every base face
+  /// @param[in,out] io_faceAlive 1 for every face that is still in the mesh, 0 if it was removed
+  //----------------------------------------------------------------------------------------------------------------------
+  void replay( unsigned int _from, unsigned int _to,
+               std::vector<int> &io_faceVerts, std::vector<char> &io_faceAlive ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move the vertices of records [_from, _to) to where the collapses placed them. Does nothing if no
+  ///   positions were recorded
+  /// @param[in] _from the number of records already applied to the positions
+  /// @param[in] _to the number of records the positions should have applied after the call
+  /// @param[in,out] io_verts the position of every base vertex
+  //----------------------------------------------------------------------------------------------------------------------
+  void replayPositions( unsigned int _from, unsigned int _to, std::vector<LODVec3> &io_verts ) const;
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the three vertex ids of every base triangle
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_baseFaceVerts;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief number of vertices in the base mesh
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nBaseVerts;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the collapses in the order they were done
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<CollapseRecord> m_records;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief packed removed and changed face ids for all the records
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_recordFaces;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the position of v after each collapse, empty unless the vertices are placed by the collapses
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<LODVec3> m_positions;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief true once a base mesh has been set
+  //----------------------------------------------------------------------------------------------------------------------
+  bool m_built;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+#ifndef QUADRIC_H_
+#define QUADRIC_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file Quadric.h
+/// @brief symmetric 4x4 error quadric for the Garland-Heckbert quadric error metric
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <cmath>
+
+#include "LODVec3.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class Quadric "core/include/Quadric.h"
+/// @brief the sum of squared distances to a set of planes, stored as the 10 unique values of the symmetric 4x4
+///   matrix. Each vertex starts with the planes of its faces, a collapse just adds the two quadrics together and
+///   the cost of moving a vertex to a position is one evaluate. The values are doubles as the squared plane
+///   terms cancel badly in float on models far from the origin
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 added for the QEM cost metric
+//----------------------------------------------------------------------------------------------------------------------
+class Quadric
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, an empty quadric with no error anywhere
+  //----------------------------------------------------------------------------------------------------------------------
+  Quadric()
+  {
+    for (unsigned int i=0; i<10; ++i)
+    {
+      m_q[i] = 0.0;
+    }
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief quadric of a single plane ax+by+cz+d=0
+  /// @param[in] _a the x part of the unit plane normal
+  /// @param[in] _b the y part of the unit plane normal
+  /// @param[in] _c the z part of the unit plane normal
+  /// @param[in] _d the plane offset
+  /// @param[in] _weight scales the error, eg. the area of the face the plane came from
+  //----------------------------------------------------------------------------------------------------------------------
+  Quadric( double _a, double _b, double _c, double _d, double _weight )
+  {
+    m_q[0] = _weight*_a*_a; m_q[1] = _weight*_a*_b; m_q[2] = _weight*_a*_c; m_q[3] = _weight*_a*_d;
+    m_q[4] = _weight*_b*_b; m_q[5] = _weight*_b*_c; m_q[6] = _weight*_b*_d;
+    m_q[7] = _weight*_c*_c; m_q[8] = _weight*_c*_d;
+    m_q[9] = _weight*_d*_d;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add the planes of another quadric to this one
+  //----------------------------------------------------------------------------------------------------------------------
+  Quadric& operator+=( const Quadric &_q )
+  {
+    for (unsigned int i=0; i<10; ++i)
+    {
+      m_q[i] += _q.m_q[i];
+    }
+    return *this;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the sum of two quadrics
+  //----------------------------------------------------------------------------------------------------------------------
+  Quadric operator+( const Quadric &_q ) const
+  {
+    Quadric sum(*this);
+    sum += _q;
+    return sum;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the error of a position, v^T Q v with v = (x,y,z,1)
+  /// @param[in] _p the position
+  /// @returns the weighted sum of squared distances from _p to the planes, never negative
+  //----------------------------------------------------------------------------------------------------------------------
+  double evaluate( const LODVec3 &_p ) const
+  {
+    double x = _p.m_x;
+    double y = _p.m_y;
+    double z = _p.m_z;
+    double error = x*(m_q[0]*x + 2.0*(m_q[1]*y + m_q[2]*z + m_q[3]))
+                 + y*(m_q[4]*y + 2.0*(m_q[5]*z + m_q[6]))
+                 + z*(m_q[7]*z + 2.0*m_q[8])
+                 + m_q[9];
+    // rounding can take a perfect fit just below zero
+    return error > 0.0 ? error : 0.0;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief find the position with the least error by solving the 3x3 system from the top of the matrix
+  /// @param[out] o_p the position, only written if there is one
+  /// @returns false if the system is close to singular (eg. all the planes are parallel) and there is no single
+  ///   best position
+  //----------------------------------------------------------------------------------------------------------------------
+  bool optimum( LODVec3 &o_p ) const
+  {
+    // cofactors of the symmetric 3x3 part
+    double c00 = m_q[4]*m_q[7] - m_q[5]*m_q[5];
+    double c01 = m_q[2]*m_q[5] - m_q[1]*m_q[7];
+    double c02 = m_q[1]*m_q[5] - m_q[2]*m_q[4];
+    double c11 = m_q[0]*m_q[7] - m_q[2]*m_q[2];
+    double c12 = m_q[1]*m_q[2] - m_q[0]*m_q[5];
+    double c22 = m_q[0]*m_q[4] - m_q[1]*m_q[1];
+    double det = m_q[0]*c00 + m_q[1]*c01 + m_q[2]*c02;
+    // compare against the size of the matrix so the test doesn't depend on the scale of the model
+    double scale = m_q[0] + m_q[4] + m_q[7];
+    if (std::fabs(det) <= 1e-9*scale*scale*scale)
+    {
+      return false;
+    }
+    double inv = -1.0/det;
+    o_p.m_x = float(inv*(c00*m_q[3] + c01*m_q[6] + c02*m_q[8]));
+    o_p.m_y = float(inv*(c01*m_q[3] + c11*m_q[6] + c12*m_q[8]));
+    o_p.m_z = float(inv*(c02*m_q[3] + c12*m_q[6] + c22*m_q[8]));
+    return true;
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the upper triangle of the matrix a2 ab ac ad b2 bc bd c2 cd d2
+  //----------------------------------------------------------------------------------------------------------------------
+  double m_q[10];
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
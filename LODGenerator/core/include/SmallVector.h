@@ -0,0 +1,117 @@
+#ifndef SMALLVECTOR_H_
+#define SMALLVECTOR_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file SmallVector.h
+/// @brief a list that keeps its first few entries inside itself, for the short scratch lists of the decimation
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <cstring>
+#include <new>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class SmallVector "core/include/SmallVector.h"
+/// @brief push_back only list of plain (memcpy-able) values with room for N of them inside the object, so a list
+///   made on the stack never touches the heap unless it grows past N. Past that it moves to the heap, doubling
+///   like std::vector, so an unusual vertex (eg. a non-manifold fan) still works, just not for free
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 takes the per call std::vectors out of the collapse loop
+//----------------------------------------------------------------------------------------------------------------------
+template <class T, unsigned int N>
+class SmallVector
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, an empty list using the inside storage
+  //----------------------------------------------------------------------------------------------------------------------
+  SmallVector():
+    m_data(m_inline),
+    m_size(0),
+    m_capacity(N){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief destructor, frees the heap storage if the list grew into it
+  //----------------------------------------------------------------------------------------------------------------------
+  ~SmallVector()
+  {
+    if (m_data != m_inline)
+    {
+      ::operator delete(m_data);
+    }
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of entries
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int size() const { return m_size; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get an entry
+  /// @param[in] _i the index, less than size
+  //----------------------------------------------------------------------------------------------------------------------
+  T& operator[]( unsigned int _i ) { return m_data[_i]; }
+  const T& operator[]( unsigned int _i ) const { return m_data[_i]; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the first entry
+  //----------------------------------------------------------------------------------------------------------------------
+  const T* begin() const { return m_data; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get one past the last entry
+  //----------------------------------------------------------------------------------------------------------------------
+  const T* end() const { return m_data + m_size; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief remove every entry, any heap storage is kept for the next use
+  //----------------------------------------------------------------------------------------------------------------------
+  void clear() { m_size = 0; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief add an entry at the end
+  /// @param[in] _t the entry
+  //----------------------------------------------------------------------------------------------------------------------
+  void push_back( const T &_t )
+  {
+    if (m_size == m_capacity)
+    {
+      grow();
+    }
+    m_data[m_size++] = _t;
+  }
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move the entries to heap storage twice the size
+  //----------------------------------------------------------------------------------------------------------------------
+  void grow()
+  {
+    T *data = static_cast<T*>(::operator new(m_capacity*2*sizeof(T)));
+    std::memcpy(data, m_data, m_size*sizeof(T));
+    if (m_data != m_inline)
+    {
+      ::operator delete(m_data);
+    }
+    m_data = data;
+    m_capacity *= 2;
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the list can't be copied, m_data may point into it
+  //----------------------------------------------------------------------------------------------------------------------
+  SmallVector( const SmallVector & );
+  SmallVector& operator=( const SmallVector & );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the inside storage
+  //----------------------------------------------------------------------------------------------------------------------
+  T m_inline[N];
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the entries, m_inline until the list outgrows it
+  //----------------------------------------------------------------------------------------------------------------------
+  T *m_data;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the number of entries
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_size;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the number of entries m_data has room for
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_capacity;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,28 @@
+#ifndef VERTEXWELD_H_
+#define VERTEXWELD_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file VertexWeld.h
+/// @brief merging of coincident vertex positions at load, eg. the copies an exporter makes along uv and normal
+///   seams, so the decimator sees one connected surface instead of open boundaries along every seam
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "LODVec3.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief merge the vertices that are within _epsilon of each other. The positions are put into a spatial hash
+///   of cells _epsilon wide, so only the 27 cells around a vertex need searching, and every vertex joins the
+///   lowest numbered kept vertex within _epsilon of it, or is kept itself if there is none. Merges never chain,
+///   so no vertex moves further than _epsilon. The hash is built and searched on the worker threads and the
+///   result doesn't depend on how many there are. The kept vertices keep their order and their positions,
+///   nothing is averaged
+/// @param[in,out] io_verts the vertex positions, only the kept ones are left
+/// @param[in] _epsilon the largest distance between merged vertices, 0 only merges exact duplicates
+/// @param[out] o_remap the new id of every old vertex
+/// @returns the number of vertices merged away
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int weldVertices( std::vector<LODVec3> &io_verts, float _epsilon, std::vector<int> &o_remap );
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
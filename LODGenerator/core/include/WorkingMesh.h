@@ -0,0 +1,204 @@
+#ifndef WORKINGMESH_H_
+#define WORKINGMESH_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file WorkingMesh.h
+/// @brief the index based copy of a mesh that LODMesh decimates while it builds its collapse record
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <vector>
+
+#include "LODVec3.h"
+#include "AdjacencyCSR.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class WorkingMesh "core/include/WorkingMesh.h"
+/// @brief struct of arrays working mesh for the decimation. Vertices and faces are just 32 bit ids into flat
+///   arrays: a corner table of the three vertex ids of each face, and for each vertex its position, collapse
+///   cost and target and its one-ring of neighbouring vertices and faces as packed CSR lists, so walking a
+///   ring is one contiguous read. Nothing is allocated per vertex or face and nothing has a destructor, a
+///   removed face or vertex is only unlinked from the rings of its neighbours.
+///
+///   The rings aren't a half-edge structure as the obj files can be non-manifold and a collapse can leave
+///   edges with more than two faces, the rings don't mind either. They are kept in the same order the old
+///   Vertex and Triangle classes kept them in so the collapses, and the LODs, come out the same.
+///
+///   Different vertices and faces can be changed from different threads as long as their rings don't overlap,
+///   see LODMesh::decimateInBatches
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 replaces the Vertex and Triangle classes and their pools
+//----------------------------------------------------------------------------------------------------------------------
+class WorkingMesh
+{
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief default constructor, an empty mesh
+  //----------------------------------------------------------------------------------------------------------------------
+  WorkingMesh():
+    m_markEpoch(0),
+    m_allocatedBytes(0){;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief make the working copy of a mesh from its base lists, in parallel. The rings are the base adjacency
+  ///   lists as they are, with a little room for each to grow. Costs are left for the caller to fill in
+  /// @param[in] _verts the vertex positions
+  /// @param[in] _faceVert the vertex id of each triangle corner, three per face
+  /// @param[in] _vertAdjStart start of each vertex's adjacent vertices in _vertAdj, with one extra at the end
+  /// @param[in] _vertAdj the adjacent vertex ids of every vertex, one after another
+  /// @param[in] _faceAdjStart start of each vertex's adjacent faces in _faceAdj, with one extra at the end
+  /// @param[in] _faceAdj the adjacent face ids of every vertex, one after another
+  //----------------------------------------------------------------------------------------------------------------------
+  void build( const std::vector<LODVec3> &_verts, const std::vector<int> &_faceVert,
+              const std::vector<unsigned int> &_vertAdjStart, const std::vector<unsigned int> &_vertAdj,
+              const std::vector<unsigned int> &_faceAdjStart, const std::vector<unsigned int> &_faceAdj );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief release everything
+  //----------------------------------------------------------------------------------------------------------------------
+  void clear();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is there nothing to decimate
+  //----------------------------------------------------------------------------------------------------------------------
+  bool empty() const { return m_pos.empty(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the number of vertex ids, removed vertices included
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int getNumVerts() const { return m_pos.size(); }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get the bytes allocated for the arrays and rings since the mesh was made, for the stats
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long getAllocatedBytes() const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief finds out if a face has a particular vertex
+  /// @param[in] _f the face id
+  /// @param[in] _v the vertex id
+  //----------------------------------------------------------------------------------------------------------------------
+  bool faceHasVert( int _f, int _v ) const
+  {
+    const int *fv = &m_faceVert[_f*3];
+    return (fv[0] == _v || fv[1] == _v || fv[2] == _v);
+  }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief finds out if a vertex has a particular neighbour
+  /// @param[in] _v the vertex id
+  /// @param[in] _w the neighbour's id
+  //----------------------------------------------------------------------------------------------------------------------
+  bool hasAdjVert( int _v, int _w ) const;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief work out the unit normals of some faces from the current positions, several at a time
+  /// @param[in] _faces the face ids
+  /// @param[in] _nFaces the number of ids in _faces
+  //----------------------------------------------------------------------------------------------------------------------
+  void calculateFaceNormals( const int *_faces, unsigned int _nFaces );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief take a face out of the rings of its vertices, and drop any of its edges that no other face has
+  /// @param[in] _f the face id
+  //----------------------------------------------------------------------------------------------------------------------
+  void removeFace( int _f );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief take a vertex out of the rings of its neighbours and give its own rings' room back
+  /// @param[in] _v the vertex id
+  //----------------------------------------------------------------------------------------------------------------------
+  void removeVertex( int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief move a corner of a face from one vertex to another, updating the rings of every vertex of the face.
+  ///   Its normal is left for the caller to work out again, with the other faces of the collapse
+  /// @param[in] _f the face id
+  /// @param[in] _u the vertex to replace, must be in the face
+  /// @param[in] _v the vertex to replace it with, mustn't be in the face
+  //----------------------------------------------------------------------------------------------------------------------
+  void replaceVertex( int _f, int _u, int _v );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief start a new set of vertex marks, every vertex starts unmarked. Moving on to a new epoch clears the
+  ///   old marks without touching them, so a set costs nothing to start. Only for use from one thread
+  //----------------------------------------------------------------------------------------------------------------------
+  void beginMarks();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief mark a vertex in the current set
+  /// @param[in] _v the vertex id
+  //----------------------------------------------------------------------------------------------------------------------
+  void mark( int _v ) { m_mark[_v] = m_markEpoch; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief is a vertex marked in the current set
+  /// @param[in] _v the vertex id
+  //----------------------------------------------------------------------------------------------------------------------
+  bool isMarked( int _v ) const { return m_mark[_v] == m_markEpoch; }
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the position of each vertex, only changed by collapses that move the kept vertex
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<LODVec3> m_pos;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the cheapest collapse cost of each vertex
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<float> m_cost;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the vertex each vertex collapses onto for m_cost, -1 for none
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_collapse;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set when the lazy cost updates skip working m_cost out again after a neighbouring collapse, it is
+  ///   then only done once the vertex reaches the top of the collapse cost heap
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<char> m_costStale;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the neighbouring vertices of each vertex, slices of m_vertAdjStore
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<AdjList<int> > m_vertAdj;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the faces around each vertex, slices of m_faceAdjStore
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<AdjList<int> > m_faceAdj;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the corner table, vertex id of each corner of each face, three per face
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<int> m_faceVert;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the x part of the unit normal of each face. The parts are kept in separate arrays so the face
+  ///   kernels can load and store a lane of each, see FaceKernels.h
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<float> m_faceNormalX;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the y part of the unit normal of each face
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<float> m_faceNormalY;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the z part of the unit normal of each face
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<float> m_faceNormalZ;
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief drop _w from the neighbours of _v if no face around _v still has it
+  /// @param[in] _v the vertex id
+  /// @param[in] _w the neighbour's id
+  //----------------------------------------------------------------------------------------------------------------------
+  void remIfNonNeighbour( int _v, int _w );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the mesh can't be copied, the rings point into its storage
+  //----------------------------------------------------------------------------------------------------------------------
+  WorkingMesh( const WorkingMesh & );
+  WorkingMesh& operator=( const WorkingMesh & );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the packed neighbour rings, laid out like the base adjacency
+  //----------------------------------------------------------------------------------------------------------------------
+  AdjacencyCSR<int> m_vertAdjStore;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the packed face rings, laid out like the base adjacency
+  //----------------------------------------------------------------------------------------------------------------------
+  AdjacencyCSR<int> m_faceAdjStore;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the epoch each vertex was last marked in, see beginMarks
+  //----------------------------------------------------------------------------------------------------------------------
+  std::vector<unsigned int> m_mark;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the epoch of the current set of marks
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_markEpoch;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the bytes of the arrays made by every build, see getAllocatedBytes
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned long long m_allocatedBytes;
+
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
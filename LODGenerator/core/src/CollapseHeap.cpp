@@ -0,0 +1,170 @@
+#include "CollapseHeap.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file CollapseHeap.cpp
+/// @brief implementation files for CollapseHeap class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+bool CollapseHeap::lessCost( int _a, int _b ) const
+{
+  float costA = (*m_cost)[_a];
+  float costB = (*m_cost)[_b];
+  if (costA != costB)
+  {
+    return (costA < costB);
+  }
+  return (_a < _b);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::place( int _v, unsigned int _pos )
+{
+  m_heap[_pos] = _v;
+  m_handle[_v] = _pos;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::siftUp( unsigned int _pos )
+{
+  int v = m_heap[_pos];
+  while (_pos > 0)
+  {
+    unsigned int parent = (_pos-1)/2;
+    if (!lessCost(v, m_heap[parent]))
+    {
+      break;
+    }
+    place(m_heap[parent], _pos);
+    _pos = parent;
+  }
+  place(v, _pos);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::siftDown( unsigned int _pos )
+{
+  int v = m_heap[_pos];
+  unsigned int n = m_heap.size();
+  while (true)
+  {
+    unsigned int child = 2*_pos+1;
+    if (child >= n)
+    {
+      break;
+    }
+    // pick the cheaper of the two children
+    if (child+1 < n && lessCost(m_heap[child+1], m_heap[child]))
+    {
+      ++child;
+    }
+    if (!lessCost(m_heap[child], v))
+    {
+      break;
+    }
+    place(m_heap[child], _pos);
+    _pos = child;
+  }
+  place(v, _pos);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::build( const std::vector<float> &_cost )
+{
+  clear();
+  m_cost = &_cost;
+  m_heap.resize(_cost.size());
+  m_handle.resize(_cost.size());
+  for (unsigned int i=0; i<_cost.size(); ++i)
+  {
+    m_heap[i] = i;
+    m_handle[i] = i;
+  }
+  // bottom up heapify, O(n) rather than n pushes
+  for (int i=int(m_heap.size())/2-1; i>=0; --i)
+  {
+    siftDown(i);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::clear()
+{
+  m_heap.clear();
+  m_handle.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int CollapseHeap::pop()
+{
+  int cheapest = m_heap.front();
+  remove(cheapest);
+  return cheapest;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::push( int _v )
+{
+  LOD_STAT(++m_nOperations;)
+  if ((unsigned int)_v >= m_handle.size())
+  {
+    m_handle.resize(_v+1, -1);
+  }
+  m_heap.push_back(_v);
+  m_handle[_v] = m_heap.size()-1;
+  siftUp(m_heap.size()-1);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::update( int _v )
+{
+  LOD_STAT(++m_nOperations;)
+  if (!contains(_v))
+  {
+    return;
+  }
+  reposition(m_handle[_v]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::reposition( unsigned int _pos )
+{
+  // the cost could have gone either way so try both directions, only one will move it
+  if (_pos > 0 && lessCost(m_heap[_pos], m_heap[(_pos-1)/2]))
+  {
+    siftUp(_pos);
+  }
+  else
+  {
+    siftDown(_pos);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CollapseHeap::remove( int _v )
+{
+  LOD_STAT(++m_nOperations;)
+  if (!contains(_v))
+  {
+    return;
+  }
+  unsigned int pos = m_handle[_v];
+  m_handle[_v] = -1;
+  int last = m_heap.back();
+  m_heap.pop_back();
+  if (pos == m_heap.size())
+  {
+    // _v was the last entry so nothing needs moving
+    return;
+  }
+  // move the last entry into the hole and restore the order
+  place(last, pos);
+  reposition(pos);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool CollapseHeap::contains( int _v ) const
+{
+  return ((unsigned int)_v < m_handle.size() && m_handle[_v] >= 0);
+}
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,198 @@
+#include "FaceKernels.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#if defined(FACE_KERNELS_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernels.cpp
+/// @brief implementation files for picking the face kernels, the kernels themselves are in FaceKernels.inl
+//----------------------------------------------------------------------------------------------------------------------
+
+static_assert(sizeof(LODVec3) == 3*sizeof(float), "the kernels read the positions as three floats each");
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the kernels of each instruction set, in FaceKernels<set>.cpp
+//----------------------------------------------------------------------------------------------------------------------
+const FaceKernelTable& getFaceKernelsScalar();
+#if defined(FACE_KERNELS_X86)
+const FaceKernelTable& getFaceKernelsSSE2();
+const FaceKernelTable& getFaceKernelsAVX2();
+const FaceKernelTable& getFaceKernelsAVX512();
+#endif
+
+#if defined(FACE_KERNELS_X86)
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief run cpuid
+/// @param[in] _leaf the leaf, eax
+/// @param[in] _subLeaf the sub leaf, ecx
+/// @param[out] o_regs eax, ebx, ecx and edx
+//----------------------------------------------------------------------------------------------------------------------
+static void cpuid( unsigned int _leaf, unsigned int _subLeaf, unsigned int *o_regs )
+{
+#if defined(_MSC_VER)
+  __cpuidex(reinterpret_cast<int*>(o_regs), _leaf, _subLeaf);
+#else
+  __cpuid_count(_leaf, _subLeaf, o_regs[0], o_regs[1], o_regs[2], o_regs[3]);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get which registers the os saves on a context switch, xcr0. Only valid if cpuid says there is xgetbv
+//----------------------------------------------------------------------------------------------------------------------
+static unsigned long long getSavedRegisters()
+{
+#if defined(_MSC_VER)
+  return _xgetbv(0);
+#else
+  unsigned int lo, hi;
+  __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+  return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the widest instruction set the cpu has, and the os saves the registers of
+//----------------------------------------------------------------------------------------------------------------------
+static FaceKernelISA getCpuISA()
+{
+#if defined(FACE_KERNELS_X86)
+  unsigned int regs[4];
+  cpuid(0, 0, regs);
+  unsigned int maxLeaf = regs[0];
+  cpuid(1, 0, regs);
+  if (!(regs[3] & (1u << 26)))
+  {
+    return FACE_KERNELS_SCALAR;
+  }
+  // the wider registers are only any use if the os saves them, xgetbv says which it does
+  bool hasXgetbv = (regs[2] & (1u << 27)) != 0;
+  bool hasAvx = (regs[2] & (1u << 28)) != 0;
+  if (!hasXgetbv || !hasAvx || maxLeaf < 7)
+  {
+    return FACE_KERNELS_SSE2;
+  }
+  unsigned long long saved = getSavedRegisters();
+  if ((saved & 0x6) != 0x6)
+  {
+    return FACE_KERNELS_SSE2;
+  }
+  cpuid(7, 0, regs);
+  // AVX-512 also needs the mask registers and both halves of the zmm registers saved
+  if ((regs[1] & (1u << 16)) && (saved & 0xe6) == 0xe6)
+  {
+    return FACE_KERNELS_AVX512;
+  }
+  if (regs[1] & (1u << 5))
+  {
+    return FACE_KERNELS_AVX2;
+  }
+  return FACE_KERNELS_SSE2;
+#else
+  return FACE_KERNELS_SCALAR;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the kernels of an instruction set
+/// @param[in] _isa the instruction set, the build must have it
+//----------------------------------------------------------------------------------------------------------------------
+static const FaceKernelTable& getTable( FaceKernelISA _isa )
+{
+  switch (_isa)
+  {
+#if defined(FACE_KERNELS_X86)
+    case FACE_KERNELS_SSE2 : return getFaceKernelsSSE2();
+    case FACE_KERNELS_AVX2 : return getFaceKernelsAVX2();
+    case FACE_KERNELS_AVX512 : return getFaceKernelsAVX512();
+#endif
+    default : return getFaceKernelsScalar();
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief pick the instruction set from the cpu and LODGEN_SIMD
+//----------------------------------------------------------------------------------------------------------------------
+static FaceKernelISA selectISA()
+{
+  FaceKernelISA isa = getCpuISA();
+  const char *simd = std::getenv("LODGEN_SIMD");
+  if (simd == NULL || *simd == '\0')
+  {
+    return isa;
+  }
+  static const char *s_names[NUM_FACE_KERNEL_ISAS] = {"scalar", "sse2", "avx2", "avx512"};
+  for (unsigned int i=0; i<NUM_FACE_KERNEL_ISAS; ++i)
+  {
+    if (std::strcmp(simd, s_names[i]) == 0)
+    {
+      if (i > (unsigned int)isa)
+      {
+        std::cerr<<"LODGEN_SIMD="<<simd<<" isn't supported here, using "<<s_names[isa]<<"\n";
+        return isa;
+      }
+      return (FaceKernelISA)i;
+    }
+  }
+  std::cerr<<"LODGEN_SIMD="<<simd<<" isn't one of scalar, sse2, avx2 or avx512, using "<<s_names[isa]<<"\n";
+  return isa;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the kernels in use, picked the first time
+//----------------------------------------------------------------------------------------------------------------------
+static const FaceKernelTable& kernels()
+{
+  static const FaceKernelTable &s_kernels = getTable(getFaceKernelISA());
+  return s_kernels;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+FaceKernelISA getFaceKernelISA()
+{
+  static const FaceKernelISA s_isa = selectISA();
+  return s_isa;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+const char* getFaceKernelName()
+{
+  return kernels().m_name;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int getFaceKernelWidth()
+{
+  return kernels().m_width;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void calculateFaceNormals( const LODVec3 *_pos, const int *_faceVert, const int *_faces, unsigned int _nFaces,
+                           float *o_nx, float *o_ny, float *o_nz )
+{
+  kernels().m_normals(reinterpret_cast<const float*>(_pos), _faceVert, _faces, _nFaces, o_nx, o_ny, o_nz);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void calculateFaceNormalRange( const LODVec3 *_pos, const int *_faceVert, unsigned int _begin, unsigned int _end,
+                               float *o_nx, float *o_ny, float *o_nz )
+{
+  kernels().m_normalRange(reinterpret_cast<const float*>(_pos), _faceVert, _begin, _end, o_nx, o_ny, o_nz);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+float calculateRingCurvature( const float *_nx, const float *_ny, const float *_nz,
+                              const int *_faces, unsigned int _nFaces,
+                              const int *_sideFaces, unsigned int _nSideFaces )
+{
+  return kernels().m_curvature(_nx, _ny, _nz, _faces, _nFaces, _sideFaces, _nSideFaces);
+}
+//----------------------------------------------------------------------------------------------------------------------
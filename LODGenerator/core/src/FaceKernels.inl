@@ -0,0 +1,299 @@
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernels.inl
+/// @brief the face kernels, written once over a few lane functions and built for each instruction set by
+///   FaceKernelsScalar.cpp, FaceKernelsSSE2.cpp, FaceKernelsAVX2.cpp and FaceKernelsAVX512.cpp. Each of those
+///   defines FACE_KERNELS_BUILD_<set>, FACE_KERNELS_NAME and FACE_KERNELS_TABLE, the function that returns its
+///   FaceKernelTable, before including this.
+///
+///   Everything between the target pragmas is compiled for that instruction set, so nothing in there may use the
+///   standard library: an inline function instantiated there could be the copy the linker keeps for the whole
+///   program, and then run on a cpu without the instructions. Nor may anything in there fuse a multiply and an
+///   add, the results have to be the same whichever set is used
+//----------------------------------------------------------------------------------------------------------------------
+
+#include "FaceKernels.h"
+
+#if !defined(FACE_KERNELS_BUILD_SCALAR)
+#include <immintrin.h>
+#endif
+
+#if defined(__clang__)
+#if defined(FACE_KERNELS_BUILD_SSE2)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(FACE_KERNELS_BUILD_AVX2)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(FACE_KERNELS_BUILD_AVX512)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to=function)
+#endif
+#elif defined(__GNUC__)
+#pragma GCC push_options
+// AVX-512 brings FMA with it, and gcc would fuse the multiplies and adds of the lane functions
+#pragma GCC optimize("fp-contract=off")
+// gcc's own AVX-512 intrinsics start from deliberately undefined registers, which it then warns about
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#if defined(FACE_KERNELS_BUILD_SSE2)
+#pragma GCC target("sse2")
+#elif defined(FACE_KERNELS_BUILD_AVX2)
+#pragma GCC target("avx2")
+#elif defined(FACE_KERNELS_BUILD_AVX512)
+#pragma GCC target("avx512f")
+#endif
+#endif
+
+#if defined(FACE_KERNELS_BUILD_AVX512)
+
+typedef __m512 Lanes;
+static const unsigned int s_width = 16;
+static inline Lanes lanesSet( float _f ) { return _mm512_set1_ps(_f); }
+static inline Lanes lanesLoad( const float *_f ) { return _mm512_load_ps(_f); }
+static inline void lanesStore( float *o_f, Lanes _a ) { _mm512_store_ps(o_f, _a); }
+static inline Lanes lanesAdd( Lanes _a, Lanes _b ) { return _mm512_add_ps(_a, _b); }
+static inline Lanes lanesSub( Lanes _a, Lanes _b ) { return _mm512_sub_ps(_a, _b); }
+static inline Lanes lanesMul( Lanes _a, Lanes _b ) { return _mm512_mul_ps(_a, _b); }
+static inline Lanes lanesDiv( Lanes _a, Lanes _b ) { return _mm512_div_ps(_a, _b); }
+static inline Lanes lanesSqrt( Lanes _a ) { return _mm512_sqrt_ps(_a); }
+static inline Lanes lanesMin( Lanes _a, Lanes _b ) { return _mm512_min_ps(_a, _b); }
+static inline Lanes lanesMax( Lanes _a, Lanes _b ) { return _mm512_max_ps(_a, _b); }
+// _a where _test isn't zero, otherwise _b
+static inline Lanes lanesIfNonZero( Lanes _test, Lanes _a, Lanes _b )
+{
+  return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(_test, _mm512_setzero_ps(), _CMP_NEQ_UQ), _b, _a);
+}
+// _base[_idx[k]] in lane k
+static inline Lanes lanesGather( const float *_base, const int *_idx )
+{
+  return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xffff, _mm512_load_si512(_idx), _base, 4);
+}
+
+#elif defined(FACE_KERNELS_BUILD_AVX2)
+
+typedef __m256 Lanes;
+static const unsigned int s_width = 8;
+static inline Lanes lanesSet( float _f ) { return _mm256_set1_ps(_f); }
+static inline Lanes lanesLoad( const float *_f ) { return _mm256_load_ps(_f); }
+static inline void lanesStore( float *o_f, Lanes _a ) { _mm256_store_ps(o_f, _a); }
+static inline Lanes lanesAdd( Lanes _a, Lanes _b ) { return _mm256_add_ps(_a, _b); }
+static inline Lanes lanesSub( Lanes _a, Lanes _b ) { return _mm256_sub_ps(_a, _b); }
+static inline Lanes lanesMul( Lanes _a, Lanes _b ) { return _mm256_mul_ps(_a, _b); }
+static inline Lanes lanesDiv( Lanes _a, Lanes _b ) { return _mm256_div_ps(_a, _b); }
+static inline Lanes lanesSqrt( Lanes _a ) { return _mm256_sqrt_ps(_a); }
+static inline Lanes lanesMin( Lanes _a, Lanes _b ) { return _mm256_min_ps(_a, _b); }
+static inline Lanes lanesMax( Lanes _a, Lanes _b ) { return _mm256_max_ps(_a, _b); }
+// _a where _test isn't zero, otherwise _b
+static inline Lanes lanesIfNonZero( Lanes _test, Lanes _a, Lanes _b )
+{
+  return _mm256_blendv_ps(_b, _a, _mm256_cmp_ps(_test, _mm256_setzero_ps(), _CMP_NEQ_UQ));
+}
+// _base[_idx[k]] in lane k
+static inline Lanes lanesGather( const float *_base, const int *_idx )
+{
+  __m256i idx = _mm256_load_si256(reinterpret_cast<const __m256i*>(_idx));
+  return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), _base, idx, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4);
+}
+
+#elif defined(FACE_KERNELS_BUILD_SSE2)
+
+typedef __m128 Lanes;
+static const unsigned int s_width = 4;
+static inline Lanes lanesSet( float _f ) { return _mm_set1_ps(_f); }
+static inline Lanes lanesLoad( const float *_f ) { return _mm_load_ps(_f); }
+static inline void lanesStore( float *o_f, Lanes _a ) { _mm_store_ps(o_f, _a); }
+static inline Lanes lanesAdd( Lanes _a, Lanes _b ) { return _mm_add_ps(_a, _b); }
+static inline Lanes lanesSub( Lanes _a, Lanes _b ) { return _mm_sub_ps(_a, _b); }
+static inline Lanes lanesMul( Lanes _a, Lanes _b ) { return _mm_mul_ps(_a, _b); }
+static inline Lanes lanesDiv( Lanes _a, Lanes _b ) { return _mm_div_ps(_a, _b); }
+static inline Lanes lanesSqrt( Lanes _a ) { return _mm_sqrt_ps(_a); }
+static inline Lanes lanesMin( Lanes _a, Lanes _b ) { return _mm_min_ps(_a, _b); }
+static inline Lanes lanesMax( Lanes _a, Lanes _b ) { return _mm_max_ps(_a, _b); }
+// _a where _test isn't zero, otherwise _b
+static inline Lanes lanesIfNonZero( Lanes _test, Lanes _a, Lanes _b )
+{
+  Lanes mask = _mm_cmpneq_ps(_test, _mm_setzero_ps());
+  return _mm_or_ps(_mm_and_ps(mask, _a), _mm_andnot_ps(mask, _b));
+}
+// _base[_idx[k]] in lane k, SSE2 has no gather so it is put together a lane at a time
+static inline Lanes lanesGather( const float *_base, const int *_idx )
+{
+  return _mm_set_ps(_base[_idx[3]], _base[_idx[2]], _base[_idx[1]], _base[_idx[0]]);
+}
+
+#else
+
+typedef float Lanes;
+static const unsigned int s_width = 1;
+static inline Lanes lanesSet( float _f ) { return _f; }
+static inline Lanes lanesLoad( const float *_f ) { return *_f; }
+static inline void lanesStore( float *o_f, Lanes _a ) { *o_f = _a; }
+static inline Lanes lanesAdd( Lanes _a, Lanes _b ) { return _a + _b; }
+static inline Lanes lanesSub( Lanes _a, Lanes _b ) { return _a - _b; }
+static inline Lanes lanesMul( Lanes _a, Lanes _b ) { return _a * _b; }
+static inline Lanes lanesDiv( Lanes _a, Lanes _b ) { return _a / _b; }
+static inline Lanes lanesSqrt( Lanes _a ) { return std::sqrt(_a); }
+static inline Lanes lanesMin( Lanes _a, Lanes _b ) { return _a < _b ? _a : _b; }
+static inline Lanes lanesMax( Lanes _a, Lanes _b ) { return _a > _b ? _a : _b; }
+// _a where _test isn't zero, otherwise _b
+static inline Lanes lanesIfNonZero( Lanes _test, Lanes _a, Lanes _b ) { return _test != 0.0f ? _a : _b; }
+// _base[_idx[0]]
+static inline Lanes lanesGather( const float *_base, const int *_idx ) { return _base[*_idx]; }
+
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the smaller of two counts, std::min can't be used here
+//----------------------------------------------------------------------------------------------------------------------
+static inline unsigned int smaller( unsigned int _a, unsigned int _b )
+{
+  return _a < _b ? _a : _b;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief work out the normals of s_width faces at once, the same sums as LODVec3::cross and normalize
+/// @param[in] _pos the x, y and z of each vertex position
+/// @param[in] _faceVert the vertex id of each face corner
+/// @param[in] _ids the s_width face ids, spare lanes just repeat a face
+/// @param[out] o_n the x, y and z parts of the normals, s_width of each
+//----------------------------------------------------------------------------------------------------------------------
+static void normalBatch( const float *_pos, const int *_faceVert, const int *_ids, float (*o_n)[s_width] )
+{
+  // where each corner's position starts in _pos, a row for each corner so they gather straight into lanes
+  alignas(64) int corner[3][s_width];
+  for (unsigned int k=0; k<s_width; ++k)
+  {
+    const int *fv = _faceVert + 3*_ids[k];
+    corner[0][k] = 3*fv[0];
+    corner[1][k] = 3*fv[1];
+    corner[2][k] = 3*fv[2];
+  }
+  Lanes p0x = lanesGather(_pos, corner[0]);
+  Lanes p0y = lanesGather(_pos+1, corner[0]);
+  Lanes p0z = lanesGather(_pos+2, corner[0]);
+  Lanes e1x = lanesSub(lanesGather(_pos, corner[1]), p0x);
+  Lanes e1y = lanesSub(lanesGather(_pos+1, corner[1]), p0y);
+  Lanes e1z = lanesSub(lanesGather(_pos+2, corner[1]), p0z);
+  Lanes e2x = lanesSub(lanesGather(_pos, corner[2]), p0x);
+  Lanes e2y = lanesSub(lanesGather(_pos+1, corner[2]), p0y);
+  Lanes e2z = lanesSub(lanesGather(_pos+2, corner[2]), p0z);
+  Lanes nx = lanesSub(lanesMul(e1y, e2z), lanesMul(e1z, e2y));
+  Lanes ny = lanesSub(lanesMul(e1z, e2x), lanesMul(e1x, e2z));
+  Lanes nz = lanesSub(lanesMul(e1x, e2y), lanesMul(e1y, e2x));
+  Lanes len = lanesSqrt(lanesAdd(lanesAdd(lanesMul(nx, nx), lanesMul(ny, ny)), lanesMul(nz, nz)));
+  // zero area faces are left with a zero normal
+  lanesStore(o_n[0], lanesIfNonZero(len, lanesDiv(nx, len), nx));
+  lanesStore(o_n[1], lanesIfNonZero(len, lanesDiv(ny, len), ny));
+  lanesStore(o_n[2], lanesIfNonZero(len, lanesDiv(nz, len), nz));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief see calculateFaceNormals
+//----------------------------------------------------------------------------------------------------------------------
+static void faceNormals( const float *_pos, const int *_faceVert, const int *_faces, unsigned int _nFaces,
+                         float *o_nx, float *o_ny, float *o_nz )
+{
+  alignas(64) int ids[s_width];
+  alignas(64) float n[3][s_width];
+  for (unsigned int i=0; i<_nFaces; i+=s_width)
+  {
+    unsigned int nBatch = smaller(s_width, _nFaces-i);
+    for (unsigned int k=0; k<s_width; ++k)
+    {
+      ids[k] = _faces[i + smaller(k, nBatch-1)];
+    }
+    normalBatch(_pos, _faceVert, ids, n);
+    for (unsigned int k=0; k<nBatch; ++k)
+    {
+      o_nx[ids[k]] = n[0][k];
+      o_ny[ids[k]] = n[1][k];
+      o_nz[ids[k]] = n[2][k];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief see calculateFaceNormalRange
+//----------------------------------------------------------------------------------------------------------------------
+static void faceNormalRange( const float *_pos, const int *_faceVert, unsigned int _begin, unsigned int _end,
+                             float *o_nx, float *o_ny, float *o_nz )
+{
+  alignas(64) int ids[s_width];
+  alignas(64) float n[3][s_width];
+  for (unsigned int i=_begin; i<_end; i+=s_width)
+  {
+    unsigned int nBatch = smaller(s_width, _end-i);
+    for (unsigned int k=0; k<s_width; ++k)
+    {
+      ids[k] = i + smaller(k, nBatch-1);
+    }
+    normalBatch(_pos, _faceVert, ids, n);
+    for (unsigned int k=0; k<nBatch; ++k)
+    {
+      o_nx[i+k] = n[0][k];
+      o_ny[i+k] = n[1][k];
+      o_nz[i+k] = n[2][k];
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief see calculateRingCurvature
+//----------------------------------------------------------------------------------------------------------------------
+static float ringCurvature( const float *_nx, const float *_ny, const float *_nz,
+                            const int *_faces, unsigned int _nFaces,
+                            const int *_sideFaces, unsigned int _nSideFaces )
+{
+  // the faces go down the lanes and the side faces are broadcast across them, a row of the dot product matrix
+  // at a time. Spare lanes repeat a face, which can't change the largest curvature
+  alignas(64) int ids[s_width];
+  Lanes one = lanesSet(1.0f);
+  Lanes half = lanesSet(0.5f);
+  Lanes curvature = lanesSet(0.0f);
+  for (unsigned int i=0; i<_nFaces; i+=s_width)
+  {
+    unsigned int nBatch = smaller(s_width, _nFaces-i);
+    for (unsigned int k=0; k<s_width; ++k)
+    {
+      ids[k] = _faces[i + smaller(k, nBatch-1)];
+    }
+    Lanes fx = lanesGather(_nx, ids);
+    Lanes fy = lanesGather(_ny, ids);
+    Lanes fz = lanesGather(_nz, ids);
+    Lanes minCurve = one;
+    for (unsigned int j=0; j<_nSideFaces; ++j)
+    {
+      int s = _sideFaces[j];
+      Lanes dot = lanesAdd(lanesAdd(lanesMul(fx, lanesSet(_nx[s])), lanesMul(fy, lanesSet(_ny[s]))),
+                           lanesMul(fz, lanesSet(_nz[s])));
+      // halving is exact so this is the same as (1-dot)/2
+      minCurve = lanesMin(minCurve, lanesMul(lanesSub(one, dot), half));
+    }
+    curvature = lanesMax(curvature, minCurve);
+  }
+  alignas(64) float lanes[s_width];
+  lanesStore(lanes, curvature);
+  float largest = lanes[0];
+  for (unsigned int k=1; k<s_width; ++k)
+  {
+    largest = lanes[k] > largest ? lanes[k] : largest;
+  }
+  return largest;
+}
+
+#if defined(__clang__)
+#if !defined(FACE_KERNELS_BUILD_SCALAR)
+#pragma clang attribute pop
+#endif
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the kernels built here. Outside the pragmas as it is called to pick the kernels, on any cpu
+//----------------------------------------------------------------------------------------------------------------------
+const FaceKernelTable& FACE_KERNELS_TABLE()
+{
+  static const FaceKernelTable s_table = {FACE_KERNELS_NAME, s_width, faceNormals, faceNormalRange, ringCurvature};
+  return s_table;
+}
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,15 @@
+#include "FaceKernels.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernelsAVX2.cpp
+/// @brief the face kernels built for AVX2, only called once FaceKernels.cpp has seen the cpu and the os support
+///   it. See FaceKernels.inl
+//----------------------------------------------------------------------------------------------------------------------
+
+#if defined(FACE_KERNELS_X86)
+#define FACE_KERNELS_BUILD_AVX2
+#define FACE_KERNELS_NAME "avx2"
+#define FACE_KERNELS_TABLE getFaceKernelsAVX2
+#include "FaceKernels.inl"
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,15 @@
+#include "FaceKernels.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernelsAVX512.cpp
+/// @brief the face kernels built for AVX-512, only called once FaceKernels.cpp has seen the cpu and the os
+///   support it. See FaceKernels.inl
+//----------------------------------------------------------------------------------------------------------------------
+
+#if defined(FACE_KERNELS_X86)
+#define FACE_KERNELS_BUILD_AVX512
+#define FACE_KERNELS_NAME "avx512"
+#define FACE_KERNELS_TABLE getFaceKernelsAVX512
+#include "FaceKernels.inl"
+#endif
+//----------------------------------------------------------------------------------------------------------------------
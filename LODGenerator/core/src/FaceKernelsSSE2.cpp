@@ -0,0 +1,14 @@
+#include "FaceKernels.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernelsSSE2.cpp
+/// @brief the face kernels built for SSE2, which every x86-64 cpu has. See FaceKernels.inl
+//----------------------------------------------------------------------------------------------------------------------
+
+#if defined(FACE_KERNELS_X86)
+#define FACE_KERNELS_BUILD_SSE2
+#define FACE_KERNELS_NAME "sse2"
+#define FACE_KERNELS_TABLE getFaceKernelsSSE2
+#include "FaceKernels.inl"
+#endif
+//----------------------------------------------------------------------------------------------------------------------
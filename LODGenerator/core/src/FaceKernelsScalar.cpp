@@ -0,0 +1,13 @@
+#include "FaceKernels.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file FaceKernelsScalar.cpp
+/// @brief the face kernels built without vector instructions, for cpus with none of the others and for
+///   everything that isn't x86. See FaceKernels.inl
+//----------------------------------------------------------------------------------------------------------------------
+
+#define FACE_KERNELS_BUILD_SCALAR
+#define FACE_KERNELS_NAME "scalar"
+#define FACE_KERNELS_TABLE getFaceKernelsScalar
+#include "FaceKernels.inl"
+//----------------------------------------------------------------------------------------------------------------------
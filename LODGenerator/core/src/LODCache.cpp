@@ -0,0 +1,481 @@
+#include "LODCache.h"
+#include "LODMesh.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODCache.cpp
+/// @brief implementation files for LODCache class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief change this whenever the layout of the file changes, old caches are then rebuilt
+//----------------------------------------------------------------------------------------------------------------------
+static const uint32_t s_cacheVersion = 2;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief a source modified this close to when its cache was written could have changed again within the
+///   timestamp resolution of the file system, so its contents are always checked (the same rule git uses)
+//----------------------------------------------------------------------------------------------------------------------
+static const int64_t s_racyTime = 2000000000LL;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief written as is, so a cache made on a machine with the other byte order is rejected
+//----------------------------------------------------------------------------------------------------------------------
+static const uint32_t s_byteOrder = 0x01020304;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief is the cache used, see LODCache::setEnabled
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<bool> s_enabled(true);
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the starting value of LODCache::hash, the FNV-1a offset basis
+//----------------------------------------------------------------------------------------------------------------------
+static const uint64_t s_hashBasis = 0xcbf29ce484222325ULL;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief carry LODCache::hash on over more 8 byte words, so data in separate blocks can be hashed as if it
+///   was one
+/// @param[in] _h the hash so far, s_hashBasis to start
+/// @param[in] _data the words
+/// @param[in] _size the number of bytes, a multiple of 8
+/// @returns the hash with the words added
+//----------------------------------------------------------------------------------------------------------------------
+static uint64_t hashWords( uint64_t _h, const char *_data, uint64_t _size )
+{
+  const uint64_t prime = 0x100000001b3ULL;
+  for (uint64_t i=0; i<_size; i+=8)
+  {
+    uint64_t word;
+    std::memcpy(&word, _data+i, 8);
+    _h = (_h ^ word) * prime;
+  }
+  return _h;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the id of this process, for the temporary file names
+//----------------------------------------------------------------------------------------------------------------------
+static long getProcessID()
+{
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the start of a .lodc file, followed by the sections listed in LODCacheSection
+//----------------------------------------------------------------------------------------------------------------------
+struct LODCacheHeader {
+  char m_magic[4]; ///< always LODC
+  uint32_t m_version; ///< s_cacheVersion when written
+  uint32_t m_byteOrder; ///< s_byteOrder when written
+  uint32_t m_headerSize; ///< sizeof(LODCacheHeader) when written
+  uint64_t m_sourceSize; ///< size of the obj the cache was made from
+  int64_t m_sourceTime; ///< modification time of the obj in nanoseconds
+  uint64_t m_sourceHash; ///< LODCache::hash of the obj
+  int64_t m_cacheTime; ///< when the cache was written in nanoseconds
+  uint64_t m_payloadHash; ///< LODCache::hash of everything after the header
+  uint32_t m_nVerts; ///< number of vertices
+  uint32_t m_nNorm; ///< number of normals
+  uint32_t m_nTex; ///< number of texture coords
+  uint32_t m_nFaces; ///< number of triangles
+  uint32_t m_nVertAdj; ///< total length of the adjacent vertex lists
+  uint32_t m_nFaceAdj; ///< total length of the adjacent face lists
+  float m_bboxMin[3]; ///< bounding box minimum
+  float m_bboxMax[3]; ///< bounding box maximum
+  float m_center[3]; ///< average vertex position
+  float m_weldEpsilon; ///< LODMesh::getWeldEpsilon of the load that made the cache, -1 if it didn't weld
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the sections after the header, in file order
+//----------------------------------------------------------------------------------------------------------------------
+enum LODCacheSection
+{
+  SECTION_VERTS,          ///< float x,y,z per vertex
+  SECTION_NORMALS,        ///< float x,y,z per normal
+  SECTION_TEXCORDS,       ///< float u,v,w per texture coord
+  SECTION_FACE_VERTS,     ///< int32 vertex id per triangle corner
+  SECTION_FACE_NORMALS,   ///< int32 normal id per triangle corner, -1 if none
+  SECTION_FACE_TEXCORDS,  ///< int32 texture coord id per triangle corner, -1 if none
+  SECTION_VERT_ADJ_START, ///< uint32 start of each vertex's adjacent vertices, one extra at the end
+  SECTION_VERT_ADJ,       ///< uint32 adjacent vertex ids
+  SECTION_FACE_ADJ_START, ///< uint32 start of each vertex's adjacent faces, one extra at the end
+  SECTION_FACE_ADJ,       ///< uint32 adjacent face ids
+  SECTION_COST,           ///< float initial collapse cost per vertex
+  SECTION_COLLAPSE,       ///< int32 initial collapse vertex per vertex, -1 if none
+  SECTION_COUNT
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief work out the size of every section and where it starts from the counts in the header
+/// @param[in] _header the header
+/// @param[out] o_size the size in bytes of each section, without padding
+/// @param[out] o_offset the byte offset of each section, o_offset[SECTION_COUNT] is the file size
+//----------------------------------------------------------------------------------------------------------------------
+static void sectionLayout( const LODCacheHeader &_header, uint64_t o_size[SECTION_COUNT],
+                           uint64_t o_offset[SECTION_COUNT+1] )
+{
+  uint64_t *size = o_size;
+  size[SECTION_VERTS] = uint64_t(_header.m_nVerts)*12;
+  size[SECTION_NORMALS] = uint64_t(_header.m_nNorm)*12;
+  size[SECTION_TEXCORDS] = uint64_t(_header.m_nTex)*12;
+  size[SECTION_FACE_VERTS] = uint64_t(_header.m_nFaces)*12;
+  size[SECTION_FACE_NORMALS] = uint64_t(_header.m_nFaces)*12;
+  size[SECTION_FACE_TEXCORDS] = uint64_t(_header.m_nFaces)*12;
+  size[SECTION_VERT_ADJ_START] = (uint64_t(_header.m_nVerts)+1)*4;
+  size[SECTION_VERT_ADJ] = uint64_t(_header.m_nVertAdj)*4;
+  size[SECTION_FACE_ADJ_START] = (uint64_t(_header.m_nVerts)+1)*4;
+  size[SECTION_FACE_ADJ] = uint64_t(_header.m_nFaceAdj)*4;
+  size[SECTION_COST] = uint64_t(_header.m_nVerts)*4;
+  size[SECTION_COLLAPSE] = uint64_t(_header.m_nVerts)*4;
+
+  // every section starts on an 8 byte boundary so it can be used straight from the mapping
+  o_offset[0] = sizeof(LODCacheHeader);
+  for (unsigned int i=0; i<SECTION_COUNT; ++i)
+  {
+    o_offset[i+1] = (o_offset[i] + size[i] + 7) & ~uint64_t(7);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief copy packed x,y,z floats into a list of LODVec3
+/// @param[in] _data the floats, three per vector
+/// @param[in] _n the number of vectors
+/// @param[out] o_list the list to fill
+//----------------------------------------------------------------------------------------------------------------------
+static void copyVec3( const float *_data, uint32_t _n, std::vector<LODVec3> &o_list )
+{
+  o_list.resize(_n);
+  for (uint32_t i=0; i<_n; ++i)
+  {
+    o_list[i] = LODVec3(_data[i*3], _data[i*3+1], _data[i*3+2]);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string LODCache::getCacheName( const std::string &_objName )
+{
+  std::size_t slash = _objName.find_last_of("/\\");
+  std::size_t dot = _objName.find_last_of('.');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+  {
+    return _objName + ".lodc";
+  }
+  return _objName.substr(0, dot) + ".lodc";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODCache::setEnabled( bool _enabled )
+{
+  s_enabled.store(_enabled);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODCache::getEnabled()
+{
+  return s_enabled.load();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+uint64_t LODCache::hash( const char *_data, std::size_t _size )
+{
+  const uint64_t prime = 0x100000001b3ULL;
+  std::size_t i = _size & ~std::size_t(7);
+  uint64_t h = hashWords(s_hashBasis, _data, i);
+  for (; i<_size; ++i)
+  {
+    h = (h ^ static_cast<unsigned char>(_data[i])) * prime;
+  }
+  return h;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODCache::getFileInfo( const std::string &_fname, uint64_t &o_size, int64_t &o_time )
+{
+#ifdef _WIN32
+  struct _stat64 info;
+  if (_stat64(_fname.c_str(), &info) != 0)
+  {
+    return false;
+  }
+#else
+  struct stat info;
+  if (stat(_fname.c_str(), &info) != 0)
+  {
+    return false;
+  }
+#endif
+  o_size = info.st_size;
+#if defined(_WIN32)
+  o_time = int64_t(info.st_mtime)*1000000000LL;
+#elif defined(__APPLE__)
+  o_time = int64_t(info.st_mtimespec.tv_sec)*1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+  o_time = int64_t(info.st_mtim.tv_sec)*1000000000LL + info.st_mtim.tv_nsec;
+#endif
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODCache::read( const std::string &_objName, LODMesh &o_mesh )
+{
+  uint64_t sourceSize;
+  int64_t sourceTime;
+  if (!getFileInfo(_objName, sourceSize, sourceTime))
+  {
+    return false;
+  }
+  MappedFile file;
+  if (!file.open(getCacheName(_objName)) || file.getSize() < sizeof(LODCacheHeader))
+  {
+    return false;
+  }
+
+  LODCacheHeader header;
+  std::memcpy(&header, file.getData(), sizeof(LODCacheHeader));
+  if (std::memcmp(header.m_magic, "LODC", 4) != 0 || header.m_version != s_cacheVersion ||
+      header.m_byteOrder != s_byteOrder || header.m_headerSize != sizeof(LODCacheHeader) ||
+      header.m_weldEpsilon != o_mesh.getWeldEpsilon())
+  {
+    return false;
+  }
+  uint64_t size[SECTION_COUNT];
+  uint64_t offset[SECTION_COUNT+1];
+  sectionLayout(header, size, offset);
+  if (offset[SECTION_COUNT] != file.getSize() || header.m_sourceSize != sourceSize)
+  {
+    return false;
+  }
+  // an unchanged modification time is trusted unless the source was written around the same time as the
+  // cache. Otherwise the contents decide, so a touched or copied file keeps its cache
+  if (header.m_sourceTime != sourceTime || sourceTime >= header.m_cacheTime - s_racyTime)
+  {
+    MappedFile source;
+    if (!source.open(_objName) || hash(source.getData(), source.getSize()) != header.m_sourceHash)
+    {
+      return false;
+    }
+  }
+  // catches a damaged or truncated cache
+  if (hash(file.getData()+sizeof(LODCacheHeader), file.getSize()-sizeof(LODCacheHeader)) != header.m_payloadHash)
+  {
+    return false;
+  }
+
+  const char *data = file.getData();
+  const float *verts = reinterpret_cast<const float *>(data + offset[SECTION_VERTS]);
+  const float *norms = reinterpret_cast<const float *>(data + offset[SECTION_NORMALS]);
+  const float *tex = reinterpret_cast<const float *>(data + offset[SECTION_TEXCORDS]);
+  const int32_t *faceVert = reinterpret_cast<const int32_t *>(data + offset[SECTION_FACE_VERTS]);
+  const int32_t *faceNorm = reinterpret_cast<const int32_t *>(data + offset[SECTION_FACE_NORMALS]);
+  const int32_t *faceTex = reinterpret_cast<const int32_t *>(data + offset[SECTION_FACE_TEXCORDS]);
+  const uint32_t *vertAdjStart = reinterpret_cast<const uint32_t *>(data + offset[SECTION_VERT_ADJ_START]);
+  const uint32_t *vertAdj = reinterpret_cast<const uint32_t *>(data + offset[SECTION_VERT_ADJ]);
+  const uint32_t *faceAdjStart = reinterpret_cast<const uint32_t *>(data + offset[SECTION_FACE_ADJ_START]);
+  const uint32_t *faceAdj = reinterpret_cast<const uint32_t *>(data + offset[SECTION_FACE_ADJ]);
+  const float *cost = reinterpret_cast<const float *>(data + offset[SECTION_COST]);
+  const int32_t *collapse = reinterpret_cast<const int32_t *>(data + offset[SECTION_COLLAPSE]);
+
+  // check every index as well so nothing can be indexed out of range, even from a cache that wasn't written here
+  const uint32_t nVerts = header.m_nVerts;
+  const uint32_t nFaces = header.m_nFaces;
+  std::atomic<bool> valid(vertAdjStart[0] == 0 && vertAdjStart[nVerts] == header.m_nVertAdj &&
+                          faceAdjStart[0] == 0 && faceAdjStart[nVerts] == header.m_nFaceAdj);
+  parallelFor(0, nFaces*3, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    bool ok = true;
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      ok = ok && uint32_t(faceVert[i]) < nVerts &&
+           (faceNorm[i] == -1 || uint32_t(faceNorm[i]) < header.m_nNorm) &&
+           (faceTex[i] == -1 || uint32_t(faceTex[i]) < header.m_nTex);
+    }
+    if (!ok)
+    {
+      valid = false;
+    }
+  });
+  if (!valid)
+  {
+    return false;
+  }
+  parallelFor(0, nVerts, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    bool ok = true;
+    for (unsigned int i=_begin; i<_end && ok; ++i)
+    {
+      ok = vertAdjStart[i] <= vertAdjStart[i+1] && vertAdjStart[i+1] <= header.m_nVertAdj &&
+           faceAdjStart[i] <= faceAdjStart[i+1] && faceAdjStart[i+1] <= header.m_nFaceAdj &&
+           (collapse[i] == -1 || uint32_t(collapse[i]) < nVerts);
+      for (uint32_t j=vertAdjStart[i]; j<vertAdjStart[i+1] && ok; ++j)
+      {
+        ok = vertAdj[j] < nVerts;
+      }
+      for (uint32_t j=faceAdjStart[i]; j<faceAdjStart[i+1] && ok; ++j)
+      {
+        ok = faceAdj[j] < nFaces;
+      }
+    }
+    if (!ok)
+    {
+      valid = false;
+    }
+  });
+  if (!valid)
+  {
+    return false;
+  }
+
+  // copy the lists straight out of the mapping
+  copyVec3(verts, nVerts, o_mesh.m_verts);
+  copyVec3(norms, header.m_nNorm, o_mesh.m_norm);
+  copyVec3(tex, header.m_nTex, o_mesh.m_tex);
+  o_mesh.m_faceVert.assign(faceVert, faceVert+nFaces*3);
+  o_mesh.m_faceNorm.assign(faceNorm, faceNorm+nFaces*3);
+  o_mesh.m_faceTex.assign(faceTex, faceTex+nFaces*3);
+  o_mesh.m_bboxMin = LODVec3(header.m_bboxMin[0], header.m_bboxMin[1], header.m_bboxMin[2]);
+  o_mesh.m_bboxMax = LODVec3(header.m_bboxMax[0], header.m_bboxMax[1], header.m_bboxMax[2]);
+  o_mesh.m_center = LODVec3(header.m_center[0], header.m_center[1], header.m_center[2]);
+
+  // the adjacency and costs are the base lists as they are, the working mesh is only made from them
+  // when the mesh is decimated
+  o_mesh.m_vertAdjStart.assign(vertAdjStart, vertAdjStart+nVerts+1);
+  o_mesh.m_vertAdj.assign(vertAdj, vertAdj+header.m_nVertAdj);
+  o_mesh.m_faceAdjStart.assign(faceAdjStart, faceAdjStart+nVerts+1);
+  o_mesh.m_faceAdj.assign(faceAdj, faceAdj+header.m_nFaceAdj);
+  o_mesh.m_initialCost.assign(cost, cost+nVerts);
+  o_mesh.m_initialCollapse.assign(collapse, collapse+nVerts);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODCache::write( const std::string &_objName, const char *_source, std::size_t _sourceSize,
+                      const LODMesh &_mesh )
+{
+  LODCacheHeader header;
+  std::memset(&header, 0, sizeof(LODCacheHeader));
+  std::memcpy(header.m_magic, "LODC", 4);
+  header.m_version = s_cacheVersion;
+  header.m_byteOrder = s_byteOrder;
+  header.m_headerSize = sizeof(LODCacheHeader);
+  if (!getFileInfo(_objName, header.m_sourceSize, header.m_sourceTime) || header.m_sourceSize != _sourceSize)
+  {
+    return false;
+  }
+  header.m_sourceHash = hash(_source, _sourceSize);
+  header.m_cacheTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::system_clock::now().time_since_epoch()).count();
+  header.m_nVerts = _mesh.m_verts.size();
+  header.m_nNorm = _mesh.m_norm.size();
+  header.m_nTex = _mesh.m_tex.size();
+  header.m_nFaces = _mesh.getNumFaces();
+  header.m_weldEpsilon = _mesh.getWeldEpsilon();
+  const LODVec3 *bounds[3] = {&_mesh.m_bboxMin, &_mesh.m_bboxMax, &_mesh.m_center};
+  float *headerBounds[3] = {header.m_bboxMin, header.m_bboxMax, header.m_center};
+  for (unsigned int i=0; i<3; ++i)
+  {
+    headerBounds[i][0] = bounds[i]->m_x;
+    headerBounds[i][1] = bounds[i]->m_y;
+    headerBounds[i][2] = bounds[i]->m_z;
+  }
+
+  // the adjacency is already in CSR lists
+  header.m_nVertAdj = _mesh.m_vertAdj.size();
+  header.m_nFaceAdj = _mesh.m_faceAdj.size();
+  static_assert(sizeof(unsigned int) == sizeof(uint32_t) && sizeof(int) == sizeof(int32_t),
+                "the LODMesh lists must be 32 bit to be written as they are");
+  if (_mesh.m_initialCost.size() != header.m_nVerts || _mesh.m_vertAdjStart.size() != header.m_nVerts+1)
+  {
+    return false;
+  }
+
+  // LODVec3 is three floats so the lists are written as they are
+  static_assert(sizeof(LODVec3) == 12, "LODVec3 must be packed x,y,z floats");
+  const void *section[SECTION_COUNT] = { _mesh.m_verts.data(), _mesh.m_norm.data(), _mesh.m_tex.data(),
+                                         _mesh.m_faceVert.data(), _mesh.m_faceNorm.data(), _mesh.m_faceTex.data(),
+                                         _mesh.m_vertAdjStart.data(), _mesh.m_vertAdj.data(),
+                                         _mesh.m_faceAdjStart.data(), _mesh.m_faceAdj.data(),
+                                         _mesh.m_initialCost.data(), _mesh.m_initialCollapse.data() };
+  uint64_t size[SECTION_COUNT];
+  uint64_t offset[SECTION_COUNT+1];
+  sectionLayout(header, size, offset);
+
+  // the payload hash is worked out from the lists before anything is written. Every section is padded with
+  // zeros to 8 bytes, so hashing each one then its padding gives the same words as hashing the file
+  const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  uint64_t payloadHash = s_hashBasis;
+  for (unsigned int i=0; i<SECTION_COUNT; ++i)
+  {
+    uint64_t whole = size[i] & ~uint64_t(7);
+    payloadHash = hashWords(payloadHash, static_cast<const char *>(section[i]), whole);
+    if (whole != size[i])
+    {
+      char last[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      std::memcpy(last, static_cast<const char *>(section[i])+whole, size[i]-whole);
+      payloadHash = hashWords(payloadHash, last, 8);
+    }
+    uint64_t padded = (size[i]+7) & ~uint64_t(7);
+    for (uint64_t pad=padded; pad<offset[i+1]-offset[i]; pad+=8)
+    {
+      payloadHash = hashWords(payloadHash, padding, 8);
+    }
+  }
+  header.m_payloadHash = payloadHash;
+
+  // write to a temporary file and rename it so a half written cache is never seen. Each writer has its own
+  // temporary, made with x so it fails rather than sharing one, as other processes (eg. a render farm) can be
+  // writing the cache of the same obj at the same time
+  static std::atomic<unsigned int> s_nTemporaries(0);
+  std::string cacheName = getCacheName(_objName);
+  std::stringstream tmpStream;
+  tmpStream<<cacheName<<"."<<getProcessID()<<"."<<s_nTemporaries++<<".tmp";
+  std::string tmpName = tmpStream.str();
+  std::FILE *fileOut = std::fopen(tmpName.c_str(), "wbx");
+  if (fileOut == NULL)
+  {
+    return false;
+  }
+  bool good = std::fwrite(&header, sizeof(LODCacheHeader), 1, fileOut) == 1;
+  for (unsigned int i=0; good && i<SECTION_COUNT; ++i)
+  {
+    if (size[i] != 0)
+    {
+      good = std::fwrite(section[i], size[i], 1, fileOut) == 1;
+    }
+    uint64_t nPad = offset[i+1] - (offset[i] + size[i]);
+    if (good && nPad != 0)
+    {
+      good = std::fwrite(padding, nPad, 1, fileOut) == 1;
+    }
+  }
+  good = std::fclose(fileOut) == 0 && good;
+  if (!good)
+  {
+    std::remove(tmpName.c_str());
+    return false;
+  }
+#ifdef _WIN32
+  // rename won't replace a file on windows
+  std::remove(cacheName.c_str());
+#endif
+  if (std::rename(tmpName.c_str(), cacheName.c_str()) != 0)
+  {
+    std::remove(tmpName.c_str());
+    return false;
+  }
+  return true;
+}
+//----------------------------------------------------------------------------------------------------------------------
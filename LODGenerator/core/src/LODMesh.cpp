@@ -0,0 +1,1567 @@
+#include <iostream>
+#include <cfloat>
+#include <algorithm>
+
+#include "LODMesh.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "LODCache.h"
+#include "ObjWriter.h"
+#include "FaceKernels.h"
+#include "VertexWeld.h"
+
+#include <atomic>
+#include <chrono>
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODMesh.cpp
+/// @brief implementation files for LODMesh class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief how much more the QEM metrics charge for moving a vertex off a boundary edge than off a face
+//----------------------------------------------------------------------------------------------------------------------
+const static double s_boundaryWeight = 10.0;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief added to the quadric error of collapses that would turn a face over, so they are only done last
+//----------------------------------------------------------------------------------------------------------------------
+const static double s_flipPenalty = 1e10;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief neighbours the collapse scratch list has room for before the loop starts, more than almost any vertex
+///   gets so the list seldom has to grow mid decimation
+//----------------------------------------------------------------------------------------------------------------------
+const static unsigned int s_ringScratchSize = 256;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief milliseconds since _start
+//----------------------------------------------------------------------------------------------------------------------
+static double elapsedMs( std::chrono::steady_clock::time_point _start )
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODMesh::LODMesh() :
+  m_loaded(false),
+  m_costMetric(COST_MELAX),
+  m_batchTolerance(0.0f),
+  m_recordTolerance(0.0f),
+  m_lazyCosts(false),
+  m_recordLazy(false),
+  m_weldEpsilon(-1.0f),
+  m_nDeletedFaces(0),
+  m_nBoundVerts(0),
+  m_buildTime(0.0),
+  m_extractTime(0.0),
+  m_costTime(0.0)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODMesh::LODMesh( const std::string& _fname, float _weldEpsilon ) :
+  m_loaded(false),
+  m_costMetric(COST_MELAX),
+  m_batchTolerance(0.0f),
+  m_recordTolerance(0.0f),
+  m_lazyCosts(false),
+  m_recordLazy(false),
+  m_weldEpsilon(-1.0f),
+  m_nDeletedFaces(0),
+  m_nBoundVerts(0),
+  m_buildTime(0.0),
+  m_extractTime(0.0),
+  m_costTime(0.0)
+{
+  setWeldEpsilon(_weldEpsilon);
+  // load the file in
+  m_loaded=load(_fname);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODMesh::~LODMesh()
+{
+  clearVtxTriDataOut();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// parse a vertex
+void LODMesh::parseVertex( ObjTokenizer &_tok, ObjChunk &io_chunk )
+{
+  LODVec3 v;
+  if (!_tok.parseFloat(v.m_x) || !_tok.parseFloat(v.m_y) || !_tok.parseFloat(v.m_z))
+  {
+    io_chunk.m_errors.push_back(std::make_pair(io_chunk.m_nLines, std::string("bad vertex, skipping it")));
+    return;
+  }
+  // grow the bounds here so nothing needs another pass over the vertices
+  if (io_chunk.m_verts.empty())
+  {
+    io_chunk.m_bboxMin = v;
+    io_chunk.m_bboxMax = v;
+  }
+  io_chunk.m_bboxMin.m_x = std::min(io_chunk.m_bboxMin.m_x, v.m_x);
+  io_chunk.m_bboxMin.m_y = std::min(io_chunk.m_bboxMin.m_y, v.m_y);
+  io_chunk.m_bboxMin.m_z = std::min(io_chunk.m_bboxMin.m_z, v.m_z);
+  io_chunk.m_bboxMax.m_x = std::max(io_chunk.m_bboxMax.m_x, v.m_x);
+  io_chunk.m_bboxMax.m_y = std::max(io_chunk.m_bboxMax.m_y, v.m_y);
+  io_chunk.m_bboxMax.m_z = std::max(io_chunk.m_bboxMax.m_z, v.m_z);
+  io_chunk.m_sum[0] += v.m_x;
+  io_chunk.m_sum[1] += v.m_y;
+  io_chunk.m_sum[2] += v.m_z;
+  io_chunk.m_verts.push_back(v);
+}
+
+
+//----------------------------------------------------------------------------------------------------------------------
+// parse a texture coordinate
+void LODMesh::parseTextureCoordinate( ObjTokenizer &_tok, ObjChunk &io_chunk )
+{
+  // this can be either a 2 or 3 d tex cord, if there is no third value set it to 0
+  LODVec3 vt;
+  if (!_tok.parseFloat(vt.m_x) || !_tok.parseFloat(vt.m_y))
+  {
+    io_chunk.m_errors.push_back(std::make_pair(io_chunk.m_nLines, std::string("bad texture coord, skipping it")));
+    return;
+  }
+  if (!_tok.parseFloat(vt.m_z))
+  {
+    vt.m_z = 0.0f;
+  }
+  io_chunk.m_tex.push_back(vt);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// parse a normal
+void LODMesh::parseNormal( ObjTokenizer &_tok, ObjChunk &io_chunk )
+{
+  LODVec3 vn;
+  if (!_tok.parseFloat(vn.m_x) || !_tok.parseFloat(vn.m_y) || !_tok.parseFloat(vn.m_z))
+  {
+    io_chunk.m_errors.push_back(std::make_pair(io_chunk.m_nLines, std::string("bad normal, skipping it")));
+    return;
+  }
+  io_chunk.m_norm.push_back(vn);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// parse face
+void LODMesh::parseFace( ObjTokenizer &_tok, ObjChunk &io_chunk )
+{
+  // a face entry is always a vert, followed by optional t and norm seperated by /, so V, V/T, V//N or V/T/N.
+  // the decimator only works on triangles so anything bigger is split into a fan around the first corner as it
+  // is read, that way only the first and last corners need keeping and nothing is allocated per face
+  int first[3] = {-1, -1, -1};
+  int prev[3] = {-1, -1, -1};
+  unsigned char firstRel = 0;
+  unsigned char prevRel = 0;
+  unsigned int nCorners = 0;
+  bool consistent = true;
+  int corner[3];
+  const unsigned int counts[3] = { (unsigned int)io_chunk.m_verts.size(), (unsigned int)io_chunk.m_tex.size(),
+                                   (unsigned int)io_chunk.m_norm.size() };
+  while (_tok.parseInt(corner[0]))
+  {
+    corner[1] = 0;
+    corner[2] = 0;
+    if (_tok.consume('/'))
+    {
+      if (!_tok.peek('/'))
+      {
+        _tok.parseInt(corner[1]);
+      }
+      if (_tok.consume('/'))
+      {
+        _tok.parseInt(corner[2]);
+      }
+    }
+    if (corner[0] == 0)
+    {
+      io_chunk.m_errors.push_back(std::make_pair(io_chunk.m_nLines,
+                                  std::string("bad vertex index, skipping the face")));
+      return;
+    }
+
+    // index in obj start from 1 so we need to do -1 for our array index. Negative ones count back from the
+    // last element read, the chunk doesn't know where it starts in the file yet so they are stored relative
+    // to the chunk and flagged for mergeChunks to fix. 0 means the index wasn't given
+    unsigned char rel = 0;
+    for (unsigned int i=0; i<3; ++i)
+    {
+      if (corner[i] > 0)
+      {
+        corner[i] -= 1;
+      }
+      else if (corner[i] < 0)
+      {
+        corner[i] += counts[i];
+        rel |= 1 << i;
+      }
+      else
+      {
+        corner[i] = -1;
+      }
+    }
+
+    if (nCorners == 0)
+    {
+      first[0] = corner[0]; first[1] = corner[1]; first[2] = corner[2];
+      firstRel = rel;
+    }
+    else
+    {
+      // OBJ format requires an encoding for faces which uses one of the vertex/texture/normal specifications
+      // consistently across the entire face.  eg. we can have all v/vt/vn, or all v//vn, or all v
+      consistent = consistent && ((corner[1] < 0 && !(rel & 2)) == (first[1] < 0 && !(firstRel & 2))) &&
+                                 ((corner[2] < 0 && !(rel & 4)) == (first[2] < 0 && !(firstRel & 4)));
+    }
+    if (nCorners >= 2)
+    {
+      const int *tri[3] = {first, prev, corner};
+      const unsigned char triRel[3] = {firstRel, prevRel, rel};
+      for (unsigned int j=0; j<3; ++j)
+      {
+        if (triRel[j] != 0)
+        {
+          io_chunk.m_relative.push_back(std::make_pair((unsigned int)io_chunk.m_faceVert.size(), triRel[j]));
+        }
+        io_chunk.m_faceVert.push_back(tri[j][0]);
+        io_chunk.m_faceTex.push_back(tri[j][1]);
+        io_chunk.m_faceNorm.push_back(tri[j][2]);
+      }
+    }
+    prev[0] = corner[0]; prev[1] = corner[1]; prev[2] = corner[2];
+    prevRel = rel;
+    ++nCorners;
+  }
+
+  if (!consistent)
+  {
+    io_chunk.m_errors.push_back(std::make_pair(io_chunk.m_nLines,
+                                std::string("something wrong with the face data, may not be correct")));
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::parseChunk( ObjChunk &io_chunk )
+{
+  io_chunk.m_nLines = 0;
+  ObjTokenizer tok(io_chunk.m_begin, io_chunk.m_end);
+  while (!tok.atEnd())
+  {
+    tok.skipSpace();
+    // each line is a keyword and its values, anything not used here (comments, groups, materials) is skipped
+    if (tok.matchKeyword("v"))
+    {
+      parseVertex(tok, io_chunk);
+    }
+    else if (tok.matchKeyword("vt"))
+    {
+      parseTextureCoordinate(tok, io_chunk);
+    }
+    else if (tok.matchKeyword("vn"))
+    {
+      parseNormal(tok, io_chunk);
+    }
+    else if (tok.matchKeyword("f"))
+    {
+      parseFace(tok, io_chunk);
+    }
+    tok.skipLine();
+    ++io_chunk.m_nLines;
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::mergeChunks( const std::vector<ObjChunk> &_chunks )
+{
+  // prefix sum of the chunk sizes gives where each chunk goes in the mesh lists
+  unsigned int nChunks = _chunks.size();
+  std::vector<unsigned int> vertOffset(nChunks+1, 0);
+  std::vector<unsigned int> normOffset(nChunks+1, 0);
+  std::vector<unsigned int> texOffset(nChunks+1, 0);
+  std::vector<unsigned int> cornerOffset(nChunks+1, 0);
+  std::vector<unsigned int> lineOffset(nChunks+1, 0);
+  for (unsigned int c=0; c<nChunks; ++c)
+  {
+    vertOffset[c+1] = vertOffset[c] + _chunks[c].m_verts.size();
+    normOffset[c+1] = normOffset[c] + _chunks[c].m_norm.size();
+    texOffset[c+1] = texOffset[c] + _chunks[c].m_tex.size();
+    cornerOffset[c+1] = cornerOffset[c] + _chunks[c].m_faceVert.size();
+    lineOffset[c+1] = lineOffset[c] + _chunks[c].m_nLines;
+  }
+
+  // errors are reported in file order with the line number in the file
+  for (unsigned int c=0; c<nChunks; ++c)
+  {
+    for (unsigned int i=0; i<_chunks[c].m_errors.size(); ++i)
+    {
+      std::cerr<<"line "<<lineOffset[c]+_chunks[c].m_errors[i].first+1<<": "<<_chunks[c].m_errors[i].second<<"\n";
+    }
+  }
+
+  // the bounds of the mesh are the bounds of the chunks
+  for (unsigned int c=0; c<nChunks; ++c)
+  {
+    const ObjChunk &chunk = _chunks[c];
+    if (chunk.m_verts.empty())
+    {
+      continue;
+    }
+    if (m_nBoundVerts == 0)
+    {
+      m_bboxMin = chunk.m_bboxMin;
+      m_bboxMax = chunk.m_bboxMax;
+      m_boundSum[0] = m_boundSum[1] = m_boundSum[2] = 0.0;
+    }
+    m_bboxMin.m_x = std::min(m_bboxMin.m_x, chunk.m_bboxMin.m_x);
+    m_bboxMin.m_y = std::min(m_bboxMin.m_y, chunk.m_bboxMin.m_y);
+    m_bboxMin.m_z = std::min(m_bboxMin.m_z, chunk.m_bboxMin.m_z);
+    m_bboxMax.m_x = std::max(m_bboxMax.m_x, chunk.m_bboxMax.m_x);
+    m_bboxMax.m_y = std::max(m_bboxMax.m_y, chunk.m_bboxMax.m_y);
+    m_bboxMax.m_z = std::max(m_bboxMax.m_z, chunk.m_bboxMax.m_z);
+    m_boundSum[0] += chunk.m_sum[0];
+    m_boundSum[1] += chunk.m_sum[1];
+    m_boundSum[2] += chunk.m_sum[2];
+    m_nBoundVerts += chunk.m_verts.size();
+  }
+  finishBounds();
+
+  m_verts.resize(vertOffset[nChunks]);
+  m_norm.resize(normOffset[nChunks]);
+  m_tex.resize(texOffset[nChunks]);
+  m_faceVert.resize(cornerOffset[nChunks]);
+  m_faceNorm.resize(cornerOffset[nChunks]);
+  m_faceTex.resize(cornerOffset[nChunks]);
+  const int nVerts = m_verts.size();
+  const int nNorm = m_norm.size();
+  const int nTex = m_tex.size();
+
+  // every chunk copies into its own part of the lists
+  std::vector<char> badFace(cornerOffset[nChunks]/3, 0);
+  parallelFor(0, nChunks, 1, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int c=_begin; c<_end; ++c)
+    {
+      const ObjChunk &chunk = _chunks[c];
+      std::copy(chunk.m_verts.begin(), chunk.m_verts.end(), m_verts.begin()+vertOffset[c]);
+      std::copy(chunk.m_norm.begin(), chunk.m_norm.end(), m_norm.begin()+normOffset[c]);
+      std::copy(chunk.m_tex.begin(), chunk.m_tex.end(), m_tex.begin()+texOffset[c]);
+      int *faceVert = m_faceVert.data()+cornerOffset[c];
+      int *faceNorm = m_faceNorm.data()+cornerOffset[c];
+      int *faceTex = m_faceTex.data()+cornerOffset[c];
+      std::copy(chunk.m_faceVert.begin(), chunk.m_faceVert.end(), faceVert);
+      std::copy(chunk.m_faceNorm.begin(), chunk.m_faceNorm.end(), faceNorm);
+      std::copy(chunk.m_faceTex.begin(), chunk.m_faceTex.end(), faceTex);
+
+      // relative indices can now be made absolute as the start of the chunk is known
+      for (unsigned int i=0; i<chunk.m_relative.size(); ++i)
+      {
+        unsigned int corner = chunk.m_relative[i].first;
+        unsigned char rel = chunk.m_relative[i].second;
+        if (rel & 1)
+        {
+          faceVert[corner] += vertOffset[c];
+        }
+        if (rel & 2)
+        {
+          faceTex[corner] += texOffset[c];
+        }
+        if (rel & 4)
+        {
+          faceNorm[corner] += normOffset[c];
+        }
+      }
+
+      // check the ranges, a triangle either has normals / tex cords on every corner or none of them
+      unsigned int nTris = chunk.m_faceVert.size()/3;
+      for (unsigned int i=0; i<nTris; ++i)
+      {
+        bool norm = true;
+        bool tex = true;
+        for (unsigned int j=i*3; j<i*3+3; ++j)
+        {
+          if (faceVert[j] < 0 || faceVert[j] >= nVerts)
+          {
+            badFace[cornerOffset[c]/3+i] = 1;
+          }
+          norm = norm && faceNorm[j] >= 0 && faceNorm[j] < nNorm;
+          tex = tex && faceTex[j] >= 0 && faceTex[j] < nTex;
+        }
+        for (unsigned int j=i*3; j<i*3+3; ++j)
+        {
+          faceNorm[j] = norm ? faceNorm[j] : -1;
+          faceTex[j] = tex ? faceTex[j] : -1;
+        }
+      }
+    }
+  });
+
+  // faces pointing at vertices that don't exist can't be used, this is rare so it is done in one pass after
+  unsigned int nBad = std::count(badFace.begin(), badFace.end(), 1);
+  if (nBad != 0)
+  {
+    std::cerr<<nBad<<" faces have vertex indices out of range, skipping them\n";
+    removeFaces(badFace);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::removeFaces( const std::vector<char> &_remove )
+{
+  unsigned int kept = 0;
+  for (unsigned int i=0; i<_remove.size(); ++i)
+  {
+    if (_remove[i])
+    {
+      continue;
+    }
+    for (unsigned int j=0; j<3; ++j)
+    {
+      m_faceVert[kept*3+j] = m_faceVert[i*3+j];
+      m_faceNorm[kept*3+j] = m_faceNorm[i*3+j];
+      m_faceTex[kept*3+j] = m_faceTex[i*3+j];
+    }
+    ++kept;
+  }
+  m_faceVert.resize(kept*3);
+  m_faceNorm.resize(kept*3);
+  m_faceTex.resize(kept*3);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::weldVertices()
+{
+  std::vector<int> remap;
+  if (::weldVertices(m_verts, m_weldEpsilon, remap) == 0)
+  {
+    return;
+  }
+
+  // the corners move onto the kept vertices, a face that had two corners welded together has no area left
+  unsigned int nFaces = getNumFaces();
+  std::vector<char> degenerate(nFaces, 0);
+  std::atomic<unsigned int> nDegenerate(0);
+  parallelFor(0, nFaces, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    unsigned int n = 0;
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      int *fv = &m_faceVert[i*3];
+      fv[0] = remap[fv[0]];
+      fv[1] = remap[fv[1]];
+      fv[2] = remap[fv[2]];
+      if (fv[0] == fv[1] || fv[1] == fv[2] || fv[2] == fv[0])
+      {
+        degenerate[i] = 1;
+        ++n;
+      }
+    }
+    nDegenerate += n;
+  });
+  if (nDegenerate != 0)
+  {
+    removeFaces(degenerate);
+  }
+
+  // the corners of the box can't change much but the center counted every copy of a welded vertex
+  for (unsigned int i=0; i<m_verts.size(); ++i)
+  {
+    growBounds(m_verts[i]);
+  }
+  finishBounds();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::growBounds( const LODVec3 &_v )
+{
+  if (m_nBoundVerts == 0)
+  {
+    m_bboxMin = _v;
+    m_bboxMax = _v;
+    m_boundSum[0] = m_boundSum[1] = m_boundSum[2] = 0.0;
+  }
+  m_bboxMin.m_x = std::min(m_bboxMin.m_x, _v.m_x);
+  m_bboxMin.m_y = std::min(m_bboxMin.m_y, _v.m_y);
+  m_bboxMin.m_z = std::min(m_bboxMin.m_z, _v.m_z);
+  m_bboxMax.m_x = std::max(m_bboxMax.m_x, _v.m_x);
+  m_bboxMax.m_y = std::max(m_bboxMax.m_y, _v.m_y);
+  m_bboxMax.m_z = std::max(m_bboxMax.m_z, _v.m_z);
+  m_boundSum[0] += _v.m_x;
+  m_boundSum[1] += _v.m_y;
+  m_boundSum[2] += _v.m_z;
+  ++m_nBoundVerts;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::finishBounds()
+{
+  if (m_nBoundVerts != 0)
+  {
+    m_center = LODVec3(m_boundSum[0]/m_nBoundVerts,
+                       m_boundSum[1]/m_nBoundVerts,
+                       m_boundSum[2]/m_nBoundVerts);
+  }
+  m_nBoundVerts = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::buildAdjacency()
+{
+  unsigned int nVerts = m_verts.size();
+  unsigned int nFaces = getNumFaces();
+
+  // group the triangle corners by vertex (a counting sort) so each vertex can fill in its own adjacency
+  // without touching any other vertex
+  std::vector<std::atomic<unsigned int> > cursor(nVerts);
+  parallelFor(0, nVerts, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      cursor[i].store(0, std::memory_order_relaxed);
+    }
+  });
+  parallelFor(0, nFaces, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin*3; i<_end*3; ++i)
+    {
+      cursor[m_faceVert[i]].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  std::vector<unsigned int> start(nVerts+1, 0);
+  for (unsigned int i=0; i<nVerts; ++i)
+  {
+    start[i+1] = start[i] + cursor[i].load(std::memory_order_relaxed);
+    cursor[i].store(start[i], std::memory_order_relaxed);
+  }
+  std::vector<unsigned int> vertCorners(nFaces*3);
+  parallelFor(0, nFaces, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin*3; i<_end*3; ++i)
+    {
+      vertCorners[cursor[m_faceVert[i]].fetch_add(1, std::memory_order_relaxed)] = i;
+    }
+  });
+
+  // each corner gives its vertex at most two neighbours and one face, so every vertex fills its own slots sized
+  // from its corner count and the lists are packed together afterwards. The corners are sorted first so the
+  // lists come out in the same order as adding the faces one after another would give
+  std::vector<unsigned int> vertAdj(nFaces*6);
+  std::vector<unsigned int> faceAdj(nFaces*3);
+  m_vertAdjStart.assign(nVerts+1, 0);
+  m_faceAdjStart.assign(nVerts+1, 0);
+  parallelFor(0, nVerts, 4096, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int v=_begin; v<_end; ++v)
+    {
+      unsigned int *corners = vertCorners.data()+start[v];
+      unsigned int nCorners = start[v+1]-start[v];
+      std::sort(corners, corners+nCorners);
+      unsigned int *adj = vertAdj.data()+start[v]*2;
+      unsigned int *faces = faceAdj.data()+start[v];
+      unsigned int nAdj = 0;
+      unsigned int nAdjFaces = 0;
+      for (unsigned int c=0; c<nCorners; ++c)
+      {
+        unsigned int face = corners[c]/3;
+        unsigned int j = corners[c]%3;
+        const int *fv = &m_faceVert[face*3];
+        for (unsigned int k=0; k<3; ++k)
+        {
+          if (j!=k && std::find(adj, adj+nAdj, (unsigned int)fv[k]) == adj+nAdj)
+          {
+            adj[nAdj++] = fv[k];
+          }
+        }
+        // the corners of one face are next to each other after the sort
+        if (nAdjFaces == 0 || faces[nAdjFaces-1] != face)
+        {
+          faces[nAdjFaces++] = face;
+        }
+      }
+      m_vertAdjStart[v+1] = nAdj;
+      m_faceAdjStart[v+1] = nAdjFaces;
+    }
+  });
+  for (unsigned int i=0; i<nVerts; ++i)
+  {
+    m_vertAdjStart[i+1] += m_vertAdjStart[i];
+    m_faceAdjStart[i+1] += m_faceAdjStart[i];
+  }
+  m_vertAdj.resize(m_vertAdjStart[nVerts]);
+  m_faceAdj.resize(m_faceAdjStart[nVerts]);
+  parallelFor(0, nVerts, 4096, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int v=_begin; v<_end; ++v)
+    {
+      std::copy(vertAdj.data()+start[v]*2, vertAdj.data()+start[v]*2+(m_vertAdjStart[v+1]-m_vertAdjStart[v]),
+                m_vertAdj.begin()+m_vertAdjStart[v]);
+      std::copy(faceAdj.data()+start[v], faceAdj.data()+start[v]+(m_faceAdjStart[v+1]-m_faceAdjStart[v]),
+                m_faceAdj.begin()+m_faceAdjStart[v]);
+    }
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::buildVtxTriData()
+{
+  clearVtxTriDataOut();
+  unsigned int nVerts = m_verts.size();
+  if (m_vertAdjStart.size() != nVerts+1)
+  {
+    // LODs only have their face lists
+    buildAdjacency();
+  }
+  // the working mesh is the base lists copied into arrays it can change, the rings laid out the same way with
+  // a little room for each to grow
+  m_working.build(m_verts, m_faceVert, m_vertAdjStart, m_vertAdj, m_faceAdjStart, m_faceAdj);
+
+  if (m_initialCost.size() == nVerts)
+  {
+    m_working.m_cost = m_initialCost;
+    m_working.m_collapse = m_initialCollapse;
+    return;
+  }
+
+  // first time, work the Melax costs out and keep them so they are only ever calculated once (and cached)
+  LODCostMetric metric = m_costMetric;
+  m_costMetric = COST_MELAX;
+  calculateAllEColCosts();
+  m_costMetric = metric;
+  m_initialCost = m_working.m_cost;
+  m_initialCollapse = m_working.m_collapse;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::load(const std::string &_fname ) noexcept
+{
+  // see below for the obj spec and other good format data
+  // http://local.wasp.uwa.edu.au/~pbourke/dataformats/obj/
+
+  LOD_STAT(std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();)
+  // a valid cache already has everything worked out below
+  if (LODCache::getEnabled() && LODCache::read(_fname, *this))
+  {
+    LOD_STAT(m_stats.m_parseMs += elapsedMs(start);)
+    LOD_STAT(m_stats.m_bytesAllocated += getListBytes();)
+    return true;
+  }
+
+  // map the file in and scan it in place, nothing is copied out of it line by line
+  MappedFile file;
+  if (!file.open(_fname))
+  {
+    std::cout<<"FILE NOT FOUND !!!! "<<_fname.c_str()<<"\n";
+    return false;
+  }
+
+  // split the file into one chunk per thread, each chunk ends on a newline so no line is split. Small files
+  // aren't worth splitting
+  const std::size_t minChunkSize = 1 << 20;
+  const char *data = file.getData();
+  std::size_t size = file.getSize();
+  unsigned int nChunks = std::max<std::size_t>(1, std::min<std::size_t>(getNumWorkerThreads(), size/minChunkSize));
+  std::vector<ObjChunk> chunks(nChunks);
+  const char *begin = data;
+  for (unsigned int c=0; c<nChunks; ++c)
+  {
+    const char *end = data + size*(c+1)/nChunks;
+    end = std::max(begin, end);
+    while (end < data+size && end[-1] != '\n')
+    {
+      ++end;
+    }
+    chunks[c].m_begin = begin;
+    chunks[c].m_end = end;
+    begin = end;
+  }
+
+  // parse the chunks in parallel then put them together in file order
+  parallelFor(0, nChunks, 1, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int c=_begin; c<_end; ++c)
+    {
+      parseChunk(chunks[c]);
+    }
+  });
+  mergeChunks(chunks);
+  if (m_weldEpsilon >= 0.0f)
+  {
+    weldVertices();
+  }
+  LOD_STAT(m_stats.m_parseMs += elapsedMs(start);)
+
+  // build the adjacency and work out the Edge Collapse costs at the start, the working mesh they need is kept
+  // for the first buildProgressiveMesh
+  LOD_STAT(start = std::chrono::steady_clock::now();)
+  LOD_STAT(double costMs = m_stats.m_costMs;)
+  LOD_STAT(unsigned long long workingBytes = getWorkingBytes();)
+  buildAdjacency();
+  buildVtxTriData();
+  LOD_STAT(m_stats.m_adjacencyMs += elapsedMs(start) - (m_stats.m_costMs - costMs);)
+  LOD_STAT(m_stats.m_bytesAllocated += getListBytes() + getWorkingBytes() - workingBytes;)
+
+  // save all that for next time, a cache that can't be written (eg. a read only folder) is just skipped
+  if (LODCache::getEnabled())
+  {
+    LODCache::write(_fname, file.getData(), file.getSize(), *this);
+  }
+
+  return true;
+
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODMesh::LODMesh( const LODMesh &_base, unsigned int _nCollapses ) :
+  m_loaded(true),
+  m_costMetric(COST_MELAX),
+  m_batchTolerance(0.0f),
+  m_recordTolerance(0.0f),
+  m_lazyCosts(false),
+  m_recordLazy(false),
+  m_weldEpsilon(-1.0f),
+  m_nDeletedFaces(0),
+  m_nBoundVerts(0),
+  m_buildTime(0.0),
+  m_extractTime(0.0),
+  m_costTime(0.0)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  // replay the first _nCollapses records over the base faces
+  std::vector<int> faceVerts;
+  std::vector<char> faceAlive;
+  _base.m_progressiveMesh.replay(_nCollapses, faceVerts, faceAlive);
+  unsigned int nFaces = _base.m_progressiveMesh.facesAfter(_nCollapses);
+  if (!_base.m_progressiveMesh.hasPositions())
+  {
+    extractReplay(_base, _base.m_verts, faceVerts, faceAlive, nFaces);
+  }
+  else
+  {
+    // the collapses moved the vertices they kept so their positions need replaying too
+    std::vector<LODVec3> verts = _base.m_verts;
+    _base.m_progressiveMesh.replayPositions(0, _nCollapses, verts);
+    extractReplay(_base, verts, faceVerts, faceAlive, nFaces);
+  }
+  m_extractTime = elapsedMs(start);
+  LOD_STAT(m_stats.m_extractMs += m_extractTime;)
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief copy one attribute stream (positions, normals or texture coords) of the faces left into a LOD,
+///   renumbered in the order the corners first use them so only the values still used are kept
+/// @param[in] _faces the ids of the faces left, in order
+/// @param[in] _corners the old value id of every corner of the base faces, -1 for none
+/// @param[in] _values the old values
+/// @param[out] o_corners the new value id of every corner of _faces, already sized
+/// @param[out] o_values the values used, in their new order
+//----------------------------------------------------------------------------------------------------------------------
+static void compactStream( const std::vector<unsigned int> &_faces, const std::vector<int> &_corners,
+                           const std::vector<LODVec3> &_values, std::vector<int> &o_corners,
+                           std::vector<LODVec3> &o_values )
+{
+  // a dense old to new table, -1 means not added yet
+  std::vector<int> remap(_values.size(), -1);
+  o_values.reserve(std::min<std::size_t>(_values.size(), _faces.size()*3));
+  for (unsigned int i=0; i<_faces.size(); ++i)
+  {
+    for (unsigned int j=0; j<3; ++j)
+    {
+      int oldID = _corners[_faces[i]*3+j];
+      if (oldID >= 0 && remap[oldID] < 0)
+      {
+        remap[oldID] = o_values.size();
+        o_values.push_back(_values[oldID]);
+      }
+      o_corners[i*3+j] = oldID >= 0 ? remap[oldID] : -1;
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::extractReplay( const LODMesh &_base, const std::vector<LODVec3> &_verts,
+                             const std::vector<int> &_faceVerts,
+                             const std::vector<char> &_faceAlive, unsigned int _nFaces )
+{
+  m_loaded = true;
+
+  // the faces left keep their order, so one pass over the alive flags lists them
+  std::vector<unsigned int> faces;
+  faces.reserve(_nFaces);
+  for (unsigned int i=0; i<_faceAlive.size(); ++i)
+  {
+    if (_faceAlive[i])
+    {
+      faces.push_back(i);
+    }
+  }
+  m_faceVert.resize(faces.size()*3);
+  m_faceNorm.resize(faces.size()*3);
+  m_faceTex.resize(faces.size()*3);
+
+  // the positions, normals and texture coords are renumbered separately so each stream gets its own thread. The
+  // positions come from the replayed faces as the vertices might have been collapsed, the corners keep their
+  // original normals and texture coords
+  parallelFor(0, 3, 1, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int stream=_begin; stream<_end; ++stream)
+    {
+      if (stream == 0)
+      {
+        compactStream(faces, _faceVerts, _verts, m_faceVert, m_verts);
+        for (unsigned int i=0; i<m_verts.size(); ++i)
+        {
+          growBounds(m_verts[i]);
+        }
+        finishBounds();
+      }
+      else if (stream == 1)
+      {
+        compactStream(faces, _base.m_faceNorm, _base.m_norm, m_faceNorm, m_norm);
+      }
+      else
+      {
+        compactStream(faces, _base.m_faceTex, _base.m_tex, m_faceTex, m_tex);
+      }
+    }
+  });
+  LOD_STAT(m_stats.m_bytesAllocated += getListBytes();)
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::save(const std::string& _fname, unsigned int _precision)const
+{
+  LOD_STAT(std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();)
+  ObjWriter writer(_precision);
+  if (!writer.open(_fname))
+  {
+    std::cout <<"File : "<<_fname<<" Not founds "<<std::endl;
+    return false;
+  }
+  // write out some comments
+  writer.writeLine("# This file was created by LODGenerator "+_fname);
+  // the verts, tex cords (only u and v) and normals, each block formatted in parallel chunks
+  writer.writeVec3Block("v ", m_verts, 3);
+  writer.writeVec3Block("vt ", m_tex, 2);
+  writer.writeVec3Block("vn ", m_norm, 3);
+  // finally the faces, V/T/N for each corner leaving out anything the face doesn't have
+  writer.writeFaceBlock(m_faceVert, m_faceTex, m_faceNorm);
+  bool written = writer.close();
+  LOD_STAT(m_stats.m_saveMs += elapsedMs(start);)
+  return written;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+float LODMesh::calculateEColCost( int _u, int _v )
+{
+  const AdjList<int> &faces = m_working.m_faceAdj[_u];
+  float edgeLength = (m_working.m_pos[_v] - m_working.m_pos[_u]).length();
+
+  // an edge only has more than a couple of faces where the mesh isn't manifold, so this stays on the stack
+  SmallVector<int, 8> sideFaces;
+
+  // Find what triangles are adjacent to both vertices
+  for (unsigned int i=0; i < faces.size(); ++i)
+  {
+    if(m_working.faceHasVert(faces[i], _v))
+    {
+      sideFaces.push_back(faces[i]);
+    }
+  }
+
+  // use the triangle facing most away from the this side faces
+  // to determine the curvature term, a batch of faces at a time
+  float curvature = calculateRingCurvature(m_working.m_faceNormalX.data(), m_working.m_faceNormalY.data(),
+                                           m_working.m_faceNormalZ.data(), faces.begin(), faces.size(),
+                                           sideFaces.begin(), sideFaces.size());
+  // the more coplanar the lower the curvature term
+  return edgeLength * curvature;
+}
+//----------------------------------------------------------------------------------------------------------------------
+double LODMesh::calculateQuadricPosition( int _u, int _v, LODVec3 &o_pos )
+{
+  // after the collapse _v carries the planes of both vertices
+  Quadric q = m_quadrics[_u] + m_quadrics[_v];
+  o_pos = m_working.m_pos[_v];
+  double cost = q.evaluate(o_pos);
+  LODVec3 best;
+  if (m_costMetric == COST_QEM_OPTIMAL && q.optimum(best))
+  {
+    // the solve can lose precision on nearly flat patches so only move if it really is better
+    double bestCost = q.evaluate(best);
+    if (bestCost < cost)
+    {
+      o_pos = best;
+      cost = bestCost;
+    }
+  }
+  return cost;
+}
+//----------------------------------------------------------------------------------------------------------------------
+float LODMesh::calculateQuadricCost( int _u, int _v, LODVec3 &o_pos )
+{
+  double cost = calculateQuadricPosition(_u, _v, o_pos);
+  // moving the faces around _u (and _v when it is placed) mustn't turn any of them over, that folds the surface
+  // and the planes can't see it
+  const LODVec3 &v = m_working.m_pos[_v];
+  bool moved = (o_pos.m_x != v.m_x || o_pos.m_y != v.m_y || o_pos.m_z != v.m_z);
+  if (flipsFace(_u, _v, o_pos) || (moved && flipsFace(_v, _u, o_pos)))
+  {
+    cost += s_flipPenalty;
+  }
+  return float(cost);
+}
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::flipsFace( int _u, int _v, const LODVec3 &_pos )
+{
+  const AdjList<int> &faces = m_working.m_faceAdj[_u];
+  const std::vector<LODVec3> &pos = m_working.m_pos;
+  for (unsigned int i=0; i<faces.size(); ++i)
+  {
+    if (m_working.faceHasVert(faces[i], _v))
+    {
+      // removed by the collapse
+      continue;
+    }
+    const int *fv = &m_working.m_faceVert[faces[i]*3];
+    LODVec3 p[3];
+    for (unsigned int j=0; j<3; ++j)
+    {
+      p[j] = (fv[j] == _u) ? _pos : pos[fv[j]];
+    }
+    const LODVec3 &p0 = pos[fv[0]];
+    LODVec3 before = (pos[fv[1]] - p0).cross(pos[fv[2]] - p0);
+    LODVec3 after = (p[1] - p[0]).cross(p[2] - p[0]);
+    if (before.dot(after) <= 0.0f)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::calculateQuadrics()
+{
+  const std::vector<LODVec3> &pos = m_working.m_pos;
+  m_quadrics.assign(m_working.getNumVerts(), Quadric());
+  // every vertex only writes its own quadric, the faces around it are summed again by each of their vertices
+  // rather than scattering a per face quadric which would need locks
+  parallelFor(0, m_working.getNumVerts(), 1024, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int v=_begin; v<_end; ++v)
+    {
+      const AdjList<int> &faces = m_working.m_faceAdj[v];
+      Quadric &q = m_quadrics[v];
+      for (unsigned int j=0; j<faces.size(); ++j)
+      {
+        const int *fv = &m_working.m_faceVert[faces[j]*3];
+        const LODVec3 &p0 = pos[fv[0]];
+        LODVec3 n = (pos[fv[1]] - p0).cross(pos[fv[2]] - p0);
+        float doubleArea = n.length();
+        if (doubleArea == 0.0f)
+        {
+          continue;
+        }
+        n = n * (1.0f/doubleArea);
+        // every plane counts the same whatever the size of its face, weighting by area lets small parts like
+        // eyes and fingers vanish long before the big flat areas are done
+        q += Quadric(n.m_x, n.m_y, n.m_z, -n.dot(p0), 1.0);
+
+        // the two edges of this face that touch v are boundaries if no other face shares them
+        for (unsigned int k=0; k<3; ++k)
+        {
+          int other = fv[k];
+          if (other == (int)v)
+          {
+            continue;
+          }
+          unsigned int nShared = 0;
+          for (unsigned int f=0; f<faces.size() && nShared < 2; ++f)
+          {
+            if (m_working.faceHasVert(faces[f], other))
+            {
+              ++nShared;
+            }
+          }
+          if (nShared != 1)
+          {
+            continue;
+          }
+          LODVec3 edge = pos[other] - pos[v];
+          LODVec3 side = edge.cross(n);
+          float sideLength = side.length();
+          if (sideLength == 0.0f)
+          {
+            continue;
+          }
+          side = side * (1.0f/sideLength);
+          q += Quadric(side.m_x, side.m_y, side.m_z, -side.dot(pos[v]), s_boundaryWeight);
+        }
+      }
+    }
+  });
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::findEColCostAtVtx( int _v )
+{
+  const AdjList<int> &adj = m_working.m_vertAdj[_v];
+  if (adj.size() == 0)
+  {
+    // v doesn't have any adjacent vertices and so it costs nothing to collapse
+    m_working.m_collapse[_v] = -1;
+    m_working.m_cost[_v] = FLT_MIN;
+    return;
+  }
+
+  // start with no vertex at the highest value
+  int collapse = -1;
+  float collapseCost = FLT_MAX;
+
+  // search all adjacent faces for the least cost edge collapse
+  for (unsigned int i=0; i<adj.size(); ++i)
+  {
+    LODVec3 pos;
+    float cost = (m_costMetric == COST_MELAX) ? calculateEColCost(_v, adj[i])
+                                               : calculateQuadricCost(_v, adj[i], pos);
+    if (cost < collapseCost)
+    {
+      // keep the collapse vertex and the collapse cost
+      collapse = adj[i];
+      collapseCost = cost;
+    }
+  }
+  m_working.m_collapse[_v] = collapse;
+  m_working.m_cost[_v] = collapseCost;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::calculateEColCostAtVtx( int _v )
+{
+  findEColCostAtVtx(_v);
+  LOD_STAT(m_stats.m_costEvaluations += m_working.m_vertAdj[_v].size();)
+  // only this vertex's entry needs moving, the rest of the heap is still in order
+  m_lodVertexCollapseCost.update(_v);
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::calculateAllEColCosts()
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  LOD_STAT(std::atomic<unsigned long long> nEvaluations(0);)
+  // each cost only reads the vertex's neighbourhood and writes the vertex itself, so the vertices can be split
+  // over the threads in any order
+  parallelFor(0, m_working.getNumVerts(), 1024, [&](unsigned int _begin, unsigned int _end)
+  {
+    LOD_STAT(unsigned long long nRangeEvaluations = 0;)
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      findEColCostAtVtx(i);
+      LOD_STAT(nRangeEvaluations += m_working.m_vertAdj[i].size();)
+    }
+    LOD_STAT(nEvaluations += nRangeEvaluations;)
+  });
+  m_costTime = elapsedMs(start);
+  LOD_STAT(m_stats.m_costMs += m_costTime;)
+  LOD_STAT(m_stats.m_costEvaluations += nEvaluations;)
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::collapseEdge( int _u, int _v )
+{
+  // temp store adjacent verts, in the scratch list that is kept between collapses so it doesn't allocate. It
+  // doubles when it is too small, assign on its own would only ever take exactly the room it needs
+  const AdjList<int> &uAdj = m_working.m_vertAdj[_u];
+  std::vector<int> &vertTmp = m_ringScratch;
+  if (vertTmp.capacity() < uAdj.size())
+  {
+    vertTmp.reserve(std::max(uAdj.size(), 2*(unsigned int)vertTmp.capacity()));
+  }
+  vertTmp.assign(uAdj.begin(), uAdj.end());
+
+  m_nDeletedFaces += applyCollapse(_u, _v, m_progressiveMesh);
+  if (_v < 0)
+  {
+    return;
+  }
+
+  if (m_costMetric != COST_MELAX)
+  {
+    updateQuadricCosts(_v, vertTmp);
+    return;
+  }
+
+  if (m_lazyCosts)
+  {
+    // leave the costs until the vertices reach the top of the heap, most never do before another collapse
+    // changes them again
+    for ( unsigned int i=0; i < vertTmp.size(); ++i)
+    {
+      m_working.m_costStale[vertTmp[i]] = 1;
+    }
+    return;
+  }
+
+  // recompute the edge collapse costs for adjacent verts for _v
+  for ( unsigned int i=0; i < vertTmp.size(); ++i)
+  {
+    calculateEColCostAtVtx(vertTmp[i]);
+  }
+
+}
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int LODMesh::applyCollapse( int _u, int _v, ProgressiveMesh &io_record )
+{
+  io_record.beginCollapse(_u, _v);
+  if (_v < 0)
+  {
+    // u is a vertex by itself so just delete it
+    m_working.removeVertex(_u);
+    return 0;
+  }
+
+  // the faces are taken off the end of u's ring as they go so it is walked backwards
+  const AdjList<int> &faces = m_working.m_faceAdj[_u];
+  unsigned int nRemoved = 0;
+  for ( int i =faces.size()-1; i >= 0; --i)
+  {
+    int f = faces[i];
+    if (m_working.faceHasVert(f, _v))
+    {
+      // record the removed face and unlink it
+      io_record.addRemovedFace(f);
+      m_working.removeFace(f);
+      // add to number of deleted faces
+      ++nRemoved;
+    }
+  }
+  // the changed faces' normals are worked out a batch at a time, a face's normal only needs its own corners so
+  // each batch can go as soon as it is full
+  const unsigned int nBatch = 16;
+  int changed[nBatch];
+  unsigned int nChanged = 0;
+  for ( int i =faces.size()-1; i >= 0; --i)
+  {
+    // update remaining triangles to have v instead of u
+    int f = faces[i];
+    io_record.addChangedFace(f);
+    m_working.replaceVertex(f, _u, _v);
+    changed[nChanged++] = f;
+    if (nChanged == nBatch || i == 0)
+    {
+      m_working.calculateFaceNormals(changed, nChanged);
+      nChanged = 0;
+    }
+  }
+  if (m_costMetric != COST_MELAX)
+  {
+    // _v takes on the planes of _u and moves to where the cost was worked out for
+    LODVec3 pos;
+    calculateQuadricPosition(_u, _v, pos);
+    m_quadrics[_v] += m_quadrics[_u];
+    if (m_costMetric == COST_QEM_OPTIMAL)
+    {
+      m_working.m_pos[_v] = pos;
+      io_record.setCollapsePosition(pos);
+    }
+  }
+  // delete the vertex _u
+  m_working.removeVertex(_u);
+  return nRemoved;
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::updateQuadricCosts( int _v, const std::vector<int> &_uAdj )
+{
+  // only the quadric of _v has changed, but the faces around every neighbour of the two vertices have too
+  calculateEColCostAtVtx(_v);
+  // mark the old neighbours of the deleted vertex so the ones around _v that were also around it are only
+  // looked at once
+  m_working.beginMarks();
+  for (unsigned int i=0; i<_uAdj.size(); ++i)
+  {
+    m_working.mark(_uAdj[i]);
+  }
+  for (unsigned int n=0; n<2; ++n)
+  {
+    const int *verts = (n == 0) ? _uAdj.data() : m_working.m_vertAdj[_v].begin();
+    unsigned int nVerts = (n == 0) ? _uAdj.size() : m_working.m_vertAdj[_v].size();
+    for (unsigned int i=0; i<nVerts; ++i)
+    {
+      int w = verts[i];
+      if (w == _v || (n == 1 && m_working.isMarked(w)))
+      {
+        continue;
+      }
+      // every edge of w is looked at again, not just the one into _v. Its quadric is the same, but its faces that
+      // had the deleted vertex now have _v, which may have moved, so the flip penalty of any of its edges can change
+      calculateEColCostAtVtx(w);
+    }
+  }
+}
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the bytes a list has reserved
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static unsigned long long listBytes( const std::vector<T> &_list )
+{
+  return _list.capacity()*(unsigned long long)sizeof(T);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long LODMesh::getListBytes() const
+{
+  return listBytes(m_verts) + listBytes(m_norm) + listBytes(m_tex) + listBytes(m_faceVert) + listBytes(m_faceNorm) +
+         listBytes(m_faceTex) + listBytes(m_vertAdjStart) + listBytes(m_vertAdj) + listBytes(m_faceAdjStart) +
+         listBytes(m_faceAdj) + listBytes(m_initialCost) + listBytes(m_initialCollapse);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long LODMesh::getWorkingBytes() const
+{
+  return m_working.getAllocatedBytes();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::clearVtxTriDataOut()
+{
+  m_working.clear();
+}
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::clearCollapseCostList()
+{
+  m_lodVertexCollapseCost.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODMesh::storeCollapseCostList()
+{
+  m_lodVertexCollapseCost.build(m_working.m_cost);
+}
+//----------------------------------------------------------------------------------------------------------------------
+
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::buildProgressiveMesh( LODCostMetric _metric )
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  LOD_STAT(unsigned long long workingBytes = getWorkingBytes();)
+  LOD_STAT(unsigned long long heapOperations = m_lodVertexCollapseCost.getNumOperations();)
+  // the working mesh is made from the base lists, unless load has just left it there. The base lists are never
+  // changed so the next build starts from the same place
+  if (m_working.empty())
+  {
+    buildVtxTriData();
+    LOD_STAT(m_stats.m_adjacencyMs += elapsedMs(start);)
+  }
+
+  // the three vertex ids of each face are what the records are replayed over, with the moved positions of the
+  // optimal quadric collapses
+  m_progressiveMesh.setBaseMesh(m_faceVert, m_verts.size(), _metric == COST_QEM_OPTIMAL);
+
+  m_costMetric = _metric;
+  if (m_costMetric != COST_MELAX)
+  {
+    // the working data came with the Melax costs so swap them for the quadric ones
+    LOD_STAT(std::chrono::steady_clock::time_point quadricStart = std::chrono::steady_clock::now();)
+    calculateQuadrics();
+    LOD_STAT(m_stats.m_costMs += elapsedMs(quadricStart);)
+    calculateAllEColCosts();
+  }
+  LOD_STAT(std::chrono::steady_clock::time_point collapseStart = std::chrono::steady_clock::now();)
+  storeCollapseCostList();
+
+  // collapse every vertex, recording each collapse in the order it happens
+  m_nDeletedFaces = 0;
+  m_recordTolerance = m_batchTolerance;
+  m_recordLazy = m_lazyCosts;
+  m_ringScratch.reserve(s_ringScratchSize);
+  // the first report is just before the first collapse and the last as soon as the heap is empty, so anything
+  // measured between the two is the collapses' own and not the set up or clearing up around them
+  bool finished = !m_progress || m_progress(0, getNumFaces());
+  if (finished && m_batchTolerance > 0.0f)
+  {
+    finished = decimateInBatches();
+  }
+  else if (finished)
+  {
+    unsigned int nReported = 0;
+    while (!m_lodVertexCollapseCost.empty() && (finished = reportProgress(nReported)))
+    {
+      // take the cheapest vertex off the top of the collapse cost heap
+      int cheapestVertex = m_lodVertexCollapseCost.top();
+      if (m_working.m_costStale[cheapestVertex])
+      {
+        // its cost is only worked out again now it has got to the top, then it goes back in at the new cost
+        m_working.m_costStale[cheapestVertex] = 0;
+        calculateEColCostAtVtx(cheapestVertex);
+        continue;
+      }
+      m_lodVertexCollapseCost.pop();
+      // collapse the edge from the cheapestVertex to its collapseVertex, this updates the heap entries of the
+      // neighbours whose cost changed so there is no need to re-sort
+      collapseEdge(cheapestVertex, m_working.m_collapse[cheapestVertex]);
+      m_progressiveMesh.endCollapse(getNumFaces() - m_nDeletedFaces);
+    }
+  }
+  if (finished && m_progress)
+  {
+    m_progress(m_nDeletedFaces, m_nDeletedFaces);
+  }
+
+  LOD_STAT(m_stats.m_collapseMs += elapsedMs(collapseStart);)
+  LOD_STAT(m_stats.m_collapses += m_progressiveMesh.getNumCollapses();)
+  LOD_STAT(m_stats.m_facesDeleted += m_nDeletedFaces;)
+  LOD_STAT(m_stats.m_heapOperations += m_lodVertexCollapseCost.getNumOperations() - heapOperations;)
+  LOD_STAT(m_stats.m_bytesAllocated += getWorkingBytes() - workingBytes;)
+  // the working copy isn't needed any more, every LOD comes from the record
+  clearCollapseCostList();
+  clearVtxTriDataOut();
+  m_quadrics.clear();
+  m_quadrics.shrink_to_fit();
+  m_buildTime = elapsedMs(start);
+  if (!finished)
+  {
+    // half a record is no use to anything, the next createLOD starts again from the base lists
+    m_progressiveMesh.clear();
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::reportProgress( unsigned int &io_nReported )
+{
+  // only every few thousand faces so the callback, and whatever it signals, doesn't slow the collapses down
+  if (!m_progress || m_nDeletedFaces - io_nReported < 4096)
+  {
+    return true;
+  }
+  io_nReported = m_nDeletedFaces;
+  return m_progress(m_nDeletedFaces, getNumFaces());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::decimateInBatches()
+{
+  const std::vector<AdjList<int> > &vertAdj = m_working.m_vertAdj;
+  std::vector<char> claimed(m_working.getNumVerts(), 0);
+  std::vector<char> affectedMark(m_working.getNumVerts(), 0);
+  std::vector<int> candidates;
+  std::vector<int> selected;
+  std::vector<int> affected;
+  std::vector<int> targets;
+  std::vector<ProgressiveMesh> parts;
+  unsigned int nReported = 0;
+  // the heap only gets smaller so the first round has the most candidates, and no vertex is affected twice in a
+  // round, so the lists never need to grow once the rounds start
+  unsigned int nMaxCandidates = std::max(1u, (unsigned int)(m_batchTolerance*m_lodVertexCollapseCost.size()));
+  candidates.reserve(nMaxCandidates);
+  selected.reserve(nMaxCandidates);
+  targets.reserve(nMaxCandidates);
+  affected.reserve(m_working.getNumVerts());
+
+  while (!m_lodVertexCollapseCost.empty())
+  {
+    m_nDeletedFaces = getNumFaces() - m_progressiveMesh.facesAfter(m_progressiveMesh.getNumCollapses());
+    if (!reportProgress(nReported))
+    {
+      return false;
+    }
+    // the round may take collapses from the cheapest _tolerance of what is left, so nothing is done more than
+    // that far ahead of where the one at a time order would do it
+    unsigned int nCandidates = std::max(1u, (unsigned int)(m_batchTolerance*m_lodVertexCollapseCost.size()));
+    candidates.clear();
+    selected.clear();
+    affected.clear();
+    for (unsigned int i=0; i<nCandidates && !m_lodVertexCollapseCost.empty(); ++i)
+    {
+      candidates.push_back(m_lodVertexCollapseCost.pop());
+    }
+
+    // take collapses cheapest first as long as the 1-ring of u (which has v in it) doesn't overlap any already
+    // taken. Everything a collapse writes is in that ring so the taken ones can run at the same time
+    for (unsigned int i=0; i<candidates.size(); ++i)
+    {
+      int u = candidates[i];
+      bool isFree = !claimed[u];
+      for (unsigned int j=0; j<vertAdj[u].size() && isFree; ++j)
+      {
+        isFree = !claimed[vertAdj[u][j]];
+      }
+      if (!isFree)
+      {
+        // try again next round, its cost may well change
+        m_lodVertexCollapseCost.push(u);
+        continue;
+      }
+      claimed[u] = 1;
+      for (unsigned int j=0; j<vertAdj[u].size(); ++j)
+      {
+        int w = vertAdj[u][j];
+        claimed[w] = 1;
+        // the neighbours of u are the costs that change, plus all around v for the quadrics
+        if (!affectedMark[w])
+        {
+          affectedMark[w] = 1;
+          affected.push_back(w);
+        }
+      }
+      selected.push_back(u);
+    }
+    for (unsigned int i=0; i<selected.size(); ++i)
+    {
+      claimed[selected[i]] = 0;
+      for (unsigned int j=0; j<vertAdj[selected[i]].size(); ++j)
+      {
+        claimed[vertAdj[selected[i]][j]] = 0;
+      }
+    }
+
+    // apply the collapses, each thread records its share separately and they are joined in the order chosen
+    unsigned int nParts = std::min(getNumWorkerThreads(), std::max(1u, (unsigned int)selected.size()/256));
+    // cleared rather than made again so each part keeps the room its records took last round
+    if (parts.size() < nParts)
+    {
+      unsigned int nMade = parts.size();
+      parts.resize(nParts);
+      for (unsigned int p=nMade; p<nParts; ++p)
+      {
+        // no round has more collapses than the first, so a part seldom needs more room than that
+        parts[p].reserve(nMaxCandidates, m_costMetric == COST_QEM_OPTIMAL);
+      }
+    }
+    for (unsigned int p=0; p<nParts; ++p)
+    {
+      parts[p].clear();
+    }
+    targets.resize(selected.size());
+    for (unsigned int i=0; i<selected.size(); ++i)
+    {
+      targets[i] = m_working.m_collapse[selected[i]];
+    }
+    parallelFor(0, nParts, 1, [&](unsigned int _begin, unsigned int _end)
+    {
+      for (unsigned int p=_begin; p<_end; ++p)
+      {
+        unsigned int first = (unsigned int)((unsigned long long)selected.size()*p/nParts);
+        unsigned int last = (unsigned int)((unsigned long long)selected.size()*(p+1)/nParts);
+        for (unsigned int i=first; i<last; ++i)
+        {
+          applyCollapse(selected[i], targets[i], parts[p]);
+        }
+      }
+    });
+    for (unsigned int p=0; p<nParts; ++p)
+    {
+      m_progressiveMesh.append(parts[p]);
+    }
+
+    if (m_costMetric != COST_MELAX)
+    {
+      // _v now carries the planes of _u so every edge into it costs something new
+      for (unsigned int i=0; i<targets.size(); ++i)
+      {
+        int v = targets[i];
+        for (unsigned int j=0; v >= 0 && j<vertAdj[v].size(); ++j)
+        {
+          int w = vertAdj[v][j];
+          if (!affectedMark[w])
+          {
+            affectedMark[w] = 1;
+            affected.push_back(w);
+          }
+        }
+      }
+    }
+
+    // work the changed costs out on the threads, then move their heap entries one at a time
+    LOD_STAT(std::atomic<unsigned long long> nEvaluations(0);)
+    parallelFor(0, affected.size(), 256, [&](unsigned int _begin, unsigned int _end)
+    {
+      LOD_STAT(unsigned long long nRangeEvaluations = 0;)
+      for (unsigned int i=_begin; i<_end; ++i)
+      {
+        findEColCostAtVtx(affected[i]);
+        LOD_STAT(nRangeEvaluations += vertAdj[affected[i]].size();)
+      }
+      LOD_STAT(nEvaluations += nRangeEvaluations;)
+    });
+    LOD_STAT(m_stats.m_costEvaluations += nEvaluations;)
+    for (unsigned int i=0; i<affected.size(); ++i)
+    {
+      affectedMark[affected[i]] = 0;
+      m_lodVertexCollapseCost.update(affected[i]);
+    }
+  }
+  m_nDeletedFaces = getNumFaces() - m_progressiveMesh.facesAfter(m_progressiveMesh.getNumCollapses());
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODMesh::isRecordCurrent( LODCostMetric _metric ) const
+{
+  return m_progressiveMesh.isBuilt() && m_costMetric == _metric && m_recordTolerance == m_batchTolerance &&
+         m_recordLazy == m_lazyCosts;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODMesh *LODMesh::createLOD(const unsigned int _nFaces, LODCostMetric _metric)
+{
+  // only decimate once per metric, after that every LOD is a replay of the collapse record
+  if (!isRecordCurrent(_metric) && !buildProgressiveMesh(_metric))
+  {
+    return NULL;
+  }
+  return new LODMesh(*this, m_progressiveMesh.collapsesForFaces(_nFaces));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODMesh *LODMesh::createLODByVertices(const unsigned int _nVerts, LODCostMetric _metric)
+{
+  if (!isRecordCurrent(_metric) && !buildProgressiveMesh(_metric))
+  {
+    return NULL;
+  }
+  return new LODMesh(*this, m_progressiveMesh.collapsesForVerts(_nVerts));
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::vector<LODMesh*> LODMesh::createLODChain( const std::vector<unsigned int> &_nFaces, LODCostMetric _metric )
+{
+  if (!isRecordCurrent(_metric) && !buildProgressiveMesh(_metric))
+  {
+    return std::vector<LODMesh*>();
+  }
+
+  // visit the targets from the most faces to the fewest so the record only has to be walked forwards
+  std::vector<unsigned int> order(_nFaces.size());
+  for (unsigned int i=0; i<order.size(); ++i)
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&_nFaces](unsigned int _a, unsigned int _b) { return _nFaces[_a] > _nFaces[_b]; });
+
+  std::vector<LODMesh*> lods(_nFaces.size(), NULL);
+  std::vector<int> faceVerts;
+  std::vector<char> faceAlive;
+  m_progressiveMesh.replay(0, faceVerts, faceAlive);
+  // only copied when the record moves vertices, otherwise every LOD uses the base positions
+  std::vector<LODVec3> verts;
+  if (m_progressiveMesh.hasPositions())
+  {
+    verts = m_verts;
+  }
+  unsigned int nApplied = 0;
+  for (unsigned int i=0; i<order.size(); ++i)
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // carry on from the last snapshot, never starting again from the base faces
+    unsigned int nCollapses = m_progressiveMesh.collapsesForFaces(_nFaces[order[i]]);
+    m_progressiveMesh.replay(nApplied, nCollapses, faceVerts, faceAlive);
+    m_progressiveMesh.replayPositions(nApplied, nCollapses, verts);
+    nApplied = std::max(nApplied, nCollapses);
+
+    LODMesh *lod = new LODMesh();
+    lod->extractReplay(*this, verts.empty() ? m_verts : verts, faceVerts, faceAlive,
+                       m_progressiveMesh.facesAfter(nApplied));
+    lod->m_extractTime = elapsedMs(start);
+    LOD_STAT(lod->m_stats.m_extractMs += lod->m_extractTime;)
+    lods[order[i]] = lod;
+  }
+  return lods;
+}
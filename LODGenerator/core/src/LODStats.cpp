@@ -0,0 +1,84 @@
+#include "LODStats.h"
+
+#include <cstdio>
+#include <fstream>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODStats.cpp
+/// @brief implementation files for LODStats struct
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODStats::reset()
+{
+  m_parseMs = 0.0;
+  m_adjacencyMs = 0.0;
+  m_costMs = 0.0;
+  m_collapseMs = 0.0;
+  m_extractMs = 0.0;
+  m_saveMs = 0.0;
+  m_costEvaluations = 0;
+  m_collapses = 0;
+  m_heapOperations = 0;
+  m_facesDeleted = 0;
+  m_bytesAllocated = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODStats::add( const LODStats &_stats )
+{
+  m_parseMs += _stats.m_parseMs;
+  m_adjacencyMs += _stats.m_adjacencyMs;
+  m_costMs += _stats.m_costMs;
+  m_collapseMs += _stats.m_collapseMs;
+  m_extractMs += _stats.m_extractMs;
+  m_saveMs += _stats.m_saveMs;
+  m_costEvaluations += _stats.m_costEvaluations;
+  m_collapses += _stats.m_collapses;
+  m_heapOperations += _stats.m_heapOperations;
+  m_facesDeleted += _stats.m_facesDeleted;
+  m_bytesAllocated += _stats.m_bytesAllocated;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+double LODStats::getFacesDeletedPerSecond() const
+{
+  return m_collapseMs > 0.0 ? m_facesDeleted/(m_collapseMs*1e-3) : 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::string LODStats::toJSON() const
+{
+  char text[1024];
+  snprintf(text, sizeof(text),
+           "{\n"
+           "  \"parse_ms\": %.3f,\n"
+           "  \"adjacency_ms\": %.3f,\n"
+           "  \"cost_ms\": %.3f,\n"
+           "  \"collapse_ms\": %.3f,\n"
+           "  \"extract_ms\": %.3f,\n"
+           "  \"save_ms\": %.3f,\n"
+           "  \"cost_evaluations\": %llu,\n"
+           "  \"collapses\": %llu,\n"
+           "  \"heap_operations\": %llu,\n"
+           "  \"faces_deleted\": %llu,\n"
+           "  \"faces_deleted_per_second\": %.0f,\n"
+           "  \"bytes_allocated\": %llu\n"
+           "}\n",
+           m_parseMs, m_adjacencyMs, m_costMs, m_collapseMs, m_extractMs, m_saveMs, m_costEvaluations, m_collapses,
+           m_heapOperations, m_facesDeleted, getFacesDeletedPerSecond(), m_bytesAllocated);
+  return text;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool LODStats::writeJSON( const std::string &_fname ) const
+{
+  std::ofstream file(_fname.c_str());
+  if (!file.is_open())
+  {
+    return false;
+  }
+  file<<toJSON();
+  file.close();
+  return !file.fail();
+}
@@ -0,0 +1,149 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file MappedFile.cpp
+/// @brief implementation files for MappedFile class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+MappedFile::MappedFile() :
+  m_data(NULL),
+  m_size(0),
+  m_open(false)
+#ifdef _WIN32
+  ,m_file(NULL),
+  m_mapping(NULL)
+#endif
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+  close();
+}
+
+#ifdef _WIN32
+//----------------------------------------------------------------------------------------------------------------------
+bool MappedFile::open( const std::string &_fname )
+{
+  close();
+  HANDLE file = CreateFileA(_fname.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return false;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    return false;
+  }
+  m_file = file;
+  m_open = true;
+  // an empty file can't be mapped but is still a valid (empty) file
+  if (size.QuadPart == 0)
+  {
+    return true;
+  }
+  m_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (m_mapping == NULL)
+  {
+    close();
+    return false;
+  }
+  m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == NULL)
+  {
+    close();
+    return false;
+  }
+  m_size = static_cast<std::size_t>(size.QuadPart);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MappedFile::close()
+{
+  if (m_data != NULL)
+  {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping != NULL)
+  {
+    CloseHandle(m_mapping);
+  }
+  if (m_file != NULL)
+  {
+    CloseHandle(m_file);
+  }
+  m_data = NULL;
+  m_mapping = NULL;
+  m_file = NULL;
+  m_size = 0;
+  m_open = false;
+}
+
+#else
+//----------------------------------------------------------------------------------------------------------------------
+bool MappedFile::open( const std::string &_fname )
+{
+  close();
+  int fd = ::open(_fname.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+  {
+    ::close(fd);
+    return false;
+  }
+  m_open = true;
+  // an empty file can't be mapped but is still a valid (empty) file
+  if (info.st_size > 0)
+  {
+    void *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      ::close(fd);
+      m_open = false;
+      return false;
+    }
+    // the loader reads it front to back once
+    madvise(data, info.st_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(data);
+    m_size = info.st_size;
+  }
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+  return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void MappedFile::close()
+{
+  if (m_data != NULL)
+  {
+    munmap(const_cast<char *>(m_data), m_size);
+  }
+  m_data = NULL;
+  m_size = 0;
+  m_open = false;
+}
+#endif
+//----------------------------------------------------------------------------------------------------------------------
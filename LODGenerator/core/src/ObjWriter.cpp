@@ -0,0 +1,199 @@
+#include "ObjWriter.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ObjWriter.cpp
+/// @brief implementation files for ObjWriter class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief number of lines formatted together by one thread
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned int s_linesPerChunk = 16384;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the most characters formatFloat writes, a sign, 17 digits, the point and an exponent fit easily
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned int s_maxFloatChars = 32;
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the most significant digits that are worth writing, past this the text only spells out more of the
+///   binary value
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned int s_maxPrecision = 17;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief write a float as printf %.*g would (to_chars uses the same rules) or as the shortest round trip
+/// @param[in] _p where to write, there must be s_maxFloatChars free
+/// @param[in] _value the float
+/// @param[in] _precision significant digits, 0 for the shortest text that reads back as _value
+/// @returns the end of the text
+//----------------------------------------------------------------------------------------------------------------------
+static char *formatFloat( char *_p, float _value, unsigned int _precision )
+{
+#if defined(__cpp_lib_to_chars)
+  if (_precision == 0)
+  {
+    return std::to_chars(_p, _p+s_maxFloatChars, _value).ptr;
+  }
+  return std::to_chars(_p, _p+s_maxFloatChars, _value, std::chars_format::general, int(_precision)).ptr;
+#else
+  // 9 significant digits is always enough to get the same float back
+  int n = snprintf(_p, s_maxFloatChars, "%.*g", _precision == 0 ? 9 : int(_precision), double(_value));
+  return _p + n;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief write a non negative int
+/// @param[in] _p where to write, there must be 10 chars free
+/// @param[in] _value the int
+/// @returns the end of the text
+//----------------------------------------------------------------------------------------------------------------------
+static char *formatIndex( char *_p, unsigned int _value )
+{
+  char digits[10];
+  unsigned int n = 0;
+  do
+  {
+    digits[n++] = char('0' + _value%10);
+    _value /= 10;
+  } while (_value != 0);
+  while (n != 0)
+  {
+    *_p++ = digits[--n];
+  }
+  return _p;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ObjWriter::ObjWriter( unsigned int _precision ) :
+  m_precision(std::min(_precision, s_maxPrecision))
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ObjWriter::open( const std::string &_fname )
+{
+  m_file.open(_fname.c_str(), std::ios::out | std::ios::trunc);
+  return m_file.is_open();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool ObjWriter::close()
+{
+  m_file.close();
+  // close sets failbit if the last flush failed, as does any write before it
+  bool ok = !m_file.fail();
+  m_file.clear();
+  return ok;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ObjWriter::writeLine( const std::string &_line )
+{
+  m_file.write(_line.data(), _line.size());
+  m_file.put('\n');
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <typename Format>
+void ObjWriter::writeBlock( unsigned int _n, unsigned int _maxLine, Format _format )
+{
+  // a round formats one chunk per buffer, so memory use depends on the thread count and not the mesh size
+  unsigned int nBuffers = std::max(1u, getNumWorkerThreads()*2);
+  if (m_buffers.size() < nBuffers)
+  {
+    m_buffers.resize(nBuffers);
+  }
+  std::vector<std::size_t> sizes(nBuffers);
+  unsigned int nChunks = (_n + s_linesPerChunk-1)/s_linesPerChunk;
+  for (unsigned int first=0; first<nChunks; first+=nBuffers)
+  {
+    unsigned int nRound = std::min(nBuffers, nChunks-first);
+    parallelFor(0, nRound, 1, [&](unsigned int _begin, unsigned int _end)
+    {
+      for (unsigned int c=_begin; c<_end; ++c)
+      {
+        unsigned int line = (first+c)*s_linesPerChunk;
+        unsigned int last = std::min(_n, line+s_linesPerChunk);
+        std::vector<char> &buffer = m_buffers[c];
+        buffer.resize(std::size_t(last-line)*_maxLine);
+        char *p = buffer.data();
+        for (; line<last; ++line)
+        {
+          p = _format(line, p);
+        }
+        sizes[c] = p - buffer.data();
+      }
+    });
+    for (unsigned int c=0; c<nRound; ++c)
+    {
+      m_file.write(m_buffers[c].data(), sizes[c]);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ObjWriter::writeVec3Block( const char *_prefix, const std::vector<LODVec3> &_values, unsigned int _nComponents )
+{
+  const unsigned int prefixSize = std::strlen(_prefix);
+  const unsigned int precision = m_precision;
+  writeBlock(_values.size(), prefixSize + _nComponents*(s_maxFloatChars+1) + 1,
+             [&](unsigned int _i, char *_p)
+  {
+    const float xyz[3] = {_values[_i].m_x, _values[_i].m_y, _values[_i].m_z};
+    std::memcpy(_p, _prefix, prefixSize);
+    _p += prefixSize;
+    for (unsigned int j=0; j<_nComponents; ++j)
+    {
+      if (j != 0)
+      {
+        *_p++ = ' ';
+      }
+      _p = formatFloat(_p, xyz[j], precision);
+    }
+    *_p++ = '\n';
+    return _p;
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ObjWriter::writeFaceBlock( const std::vector<int> &_faceVert, const std::vector<int> &_faceTex,
+                                const std::vector<int> &_faceNorm )
+{
+  // "f " then three of "v/t/n " and the newline
+  writeBlock(_faceVert.size()/3, 2 + 3*(3*10+3) + 1, [&](unsigned int _i, char *_p)
+  {
+    *_p++ = 'f';
+    *_p++ = ' ';
+    for (unsigned int j=_i*3; j<_i*3+3; ++j)
+    {
+      // don't forget that obj indices start from 1 not 0, anything the face doesn't have is left out
+      _p = formatIndex(_p, _faceVert[j]+1);
+      if (_faceTex[j] >= 0 || _faceNorm[j] >= 0)
+      {
+        *_p++ = '/';
+        if (_faceTex[j] >= 0)
+        {
+          _p = formatIndex(_p, _faceTex[j]+1);
+        }
+        if (_faceNorm[j] >= 0)
+        {
+          *_p++ = '/';
+          _p = formatIndex(_p, _faceNorm[j]+1);
+        }
+      }
+      *_p++ = ' ';
+    }
+    *_p++ = '\n';
+    return _p;
+  });
+}
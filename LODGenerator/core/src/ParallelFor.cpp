@@ -0,0 +1,32 @@
+#include "ParallelFor.h"
+
+#include <atomic>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ParallelFor.cpp
+/// @brief implementation files for the parallelFor thread count
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the thread count set by setNumWorkerThreads, 0 means use the hardware thread count
+//----------------------------------------------------------------------------------------------------------------------
+static std::atomic<unsigned int> s_nWorkerThreads(0);
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int getNumWorkerThreads()
+{
+  unsigned int nThreads = s_nWorkerThreads.load();
+  if (nThreads == 0)
+  {
+    // hardware_concurrency can return 0 if it doesn't know
+    nThreads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return nThreads;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void setNumWorkerThreads( unsigned int _nThreads )
+{
+  s_nWorkerThreads.store(_nThreads);
+}
+//----------------------------------------------------------------------------------------------------------------------
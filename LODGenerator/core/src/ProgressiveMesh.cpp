@@ -0,0 +1,212 @@
+#include "ProgressiveMesh.h"
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file ProgressiveMesh.cpp
+/// @brief implementation files for ProgressiveMesh class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::clear()
+{
+  m_baseFaceVerts.clear();
+  m_records.clear();
+  m_recordFaces.clear();
+  m_positions.clear();
+  m_nBaseVerts = 0;
+  m_built = false;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::setBaseMesh( const std::vector<int> &_faceVerts, unsigned int _nVerts, bool _positions )
+{
+  clear();
+  m_baseFaceVerts = _faceVerts;
+  m_nBaseVerts = _nVerts;
+  // every vertex is collapsed once
+  reserve(_nVerts, _positions);
+  m_built = true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::reserve( unsigned int _nCollapses, bool _positions )
+{
+  // most collapses touch around 6 faces
+  m_records.reserve(_nCollapses);
+  m_recordFaces.reserve(_nCollapses*6);
+  if (_positions)
+  {
+    m_positions.reserve(_nCollapses);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::beginCollapse( int _u, int _v )
+{
+  CollapseRecord record;
+  record.m_u = _u;
+  record.m_v = _v;
+  record.m_removedBegin = m_recordFaces.size();
+  record.m_changedBegin = m_recordFaces.size();
+  record.m_changedEnd = m_recordFaces.size();
+  record.m_nFaces = m_records.empty() ? getNumBaseFaces() : m_records.back().m_nFaces;
+  m_records.push_back(record);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::addRemovedFace( int _face )
+{
+  m_recordFaces.push_back(_face);
+  m_records.back().m_changedBegin = m_recordFaces.size();
+  m_records.back().m_changedEnd = m_recordFaces.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::addChangedFace( int _face )
+{
+  m_recordFaces.push_back(_face);
+  m_records.back().m_changedEnd = m_recordFaces.size();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::setCollapsePosition( const LODVec3 &_pos )
+{
+  if (m_positions.empty())
+  {
+    // there will be one for each record so take the same room, rather than growing while decimating
+    m_positions.reserve(m_records.capacity());
+  }
+  m_positions.resize(m_records.size());
+  m_positions.back() = _pos;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::endCollapse( unsigned int _nFaces )
+{
+  m_records.back().m_nFaces = _nFaces;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::append( const ProgressiveMesh &_batch )
+{
+  unsigned int faceOffset = m_recordFaces.size();
+  unsigned int nFaces = facesAfter(m_records.size());
+  if (_batch.hasPositions())
+  {
+    // records without a position yet keep the default, they are skipped by replayPositions if they have no v
+    if (m_positions.empty())
+    {
+      m_positions.reserve(m_records.capacity());
+    }
+    m_positions.resize(m_records.size());
+    m_positions.insert(m_positions.end(), _batch.m_positions.begin(), _batch.m_positions.end());
+  }
+  m_records.reserve(m_records.size() + _batch.m_records.size());
+  for (unsigned int i=0; i<_batch.m_records.size(); ++i)
+  {
+    CollapseRecord record = _batch.m_records[i];
+    nFaces -= record.m_changedBegin - record.m_removedBegin;
+    record.m_removedBegin += faceOffset;
+    record.m_changedBegin += faceOffset;
+    record.m_changedEnd += faceOffset;
+    record.m_nFaces = nFaces;
+    m_records.push_back(record);
+  }
+  m_recordFaces.insert(m_recordFaces.end(), _batch.m_recordFaces.begin(), _batch.m_recordFaces.end());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ProgressiveMesh::facesAfter( unsigned int _nCollapses ) const
+{
+  if (_nCollapses == 0 || m_records.empty())
+  {
+    return getNumBaseFaces();
+  }
+  return m_records[std::min<unsigned int>(_nCollapses, m_records.size())-1].m_nFaces;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ProgressiveMesh::collapsesForFaces( unsigned int _nFaces ) const
+{
+  if (_nFaces >= getNumBaseFaces())
+  {
+    return 0;
+  }
+  // the face counts never go up so find the first record at or below the target
+  unsigned int low = 0;
+  unsigned int high = m_records.size();
+  while (low < high)
+  {
+    unsigned int mid = (low+high)/2;
+    if (m_records[mid].m_nFaces <= _nFaces)
+    {
+      high = mid;
+    }
+    else
+    {
+      low = mid+1;
+    }
+  }
+  return std::min<unsigned int>(low+1, m_records.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int ProgressiveMesh::collapsesForVerts( unsigned int _nVerts ) const
+{
+  if (_nVerts >= m_nBaseVerts)
+  {
+    return 0;
+  }
+  return std::min<unsigned int>(m_nBaseVerts-_nVerts, m_records.size());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::replay( unsigned int _nCollapses, std::vector<int> &o_faceVerts,
+                             std::vector<char> &o_faceAlive ) const
+{
+  o_faceVerts = m_baseFaceVerts;
+  o_faceAlive.assign(getNumBaseFaces(), 1);
+  replay(0, _nCollapses, o_faceVerts, o_faceAlive);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::replay( unsigned int _from, unsigned int _to,
+                             std::vector<int> &io_faceVerts, std::vector<char> &io_faceAlive ) const
+{
+  _to = std::min<unsigned int>(_to, m_records.size());
+  for (unsigned int i=_from; i<_to; ++i)
+  {
+    const CollapseRecord &record = m_records[i];
+    for (unsigned int j=record.m_removedBegin; j<record.m_changedBegin; ++j)
+    {
+      io_faceAlive[m_recordFaces[j]] = 0;
+    }
+    // the faces are replayed in the same order they were collapsed so the corner holding u is still u here
+    for (unsigned int j=record.m_changedBegin; j<record.m_changedEnd; ++j)
+    {
+      int *corner = &io_faceVerts[m_recordFaces[j]*3];
+      for (unsigned int k=0; k<3; ++k)
+      {
+        if (corner[k] == record.m_u)
+        {
+          corner[k] = record.m_v;
+        }
+      }
+    }
+  }
+}
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+void ProgressiveMesh::replayPositions( unsigned int _from, unsigned int _to, std::vector<LODVec3> &io_verts ) const
+{
+  _to = std::min<unsigned int>(_to, m_positions.size());
+  for (unsigned int i=_from; i<_to; ++i)
+  {
+    if (m_records[i].m_v >= 0)
+    {
+      io_verts[m_records[i].m_v] = m_positions[i];
+    }
+  }
+}
+//----------------------------------------------------------------------------------------------------------------------
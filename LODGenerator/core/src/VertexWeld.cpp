@@ -0,0 +1,219 @@
+#include "VertexWeld.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file VertexWeld.cpp
+/// @brief implementation files for the vertex weld
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief cell coordinates further out than this are clamped, so a tiny epsilon can't overflow them. Only
+///   positions around 1e18 epsilons from the origin share the clamped cells, and they are still compared
+//----------------------------------------------------------------------------------------------------------------------
+const static double s_maxCell = 1e18;
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief the spatial hash cell of a position
+//----------------------------------------------------------------------------------------------------------------------
+struct WeldCell {
+  long long m_x; ///< the cell along x
+  long long m_y; ///< the cell along y
+  long long m_z; ///< the cell along z
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the cell of one coordinate
+/// @param[in] _x the coordinate
+/// @param[in] _epsilon the cell size, 0 makes the cell the bits of the coordinate so only equal values share it
+//----------------------------------------------------------------------------------------------------------------------
+static long long cellOf( float _x, float _epsilon )
+{
+  if (_epsilon == 0.0f)
+  {
+    // adding 0 turns -0 into +0, the two compare equal so they need the same cell
+    float x = _x + 0.0f;
+    unsigned int bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return bits;
+  }
+  double cell = std::floor(double(_x)/_epsilon);
+  return (long long)std::min(std::max(cell, -s_maxCell), s_maxCell);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the hash table bucket of a cell, the usual spatial hash of three large primes
+/// @param[in] _x the cell along x
+/// @param[in] _y the cell along y
+/// @param[in] _z the cell along z
+/// @param[in] _mask the number of buckets - 1, a power of two - 1
+//----------------------------------------------------------------------------------------------------------------------
+static unsigned int bucketOf( long long _x, long long _y, long long _z, unsigned int _mask )
+{
+  unsigned long long h = (unsigned long long)_x*73856093ULL ^ (unsigned long long)_y*19349663ULL ^
+                         (unsigned long long)_z*83492791ULL;
+  return (unsigned int)(h ^ (h >> 32)) & _mask;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief are two positions close enough to merge
+//----------------------------------------------------------------------------------------------------------------------
+static bool isNear( const LODVec3 &_a, const LODVec3 &_b, float _epsilon )
+{
+  if (_epsilon == 0.0f)
+  {
+    return _a.m_x == _b.m_x && _a.m_y == _b.m_y && _a.m_z == _b.m_z;
+  }
+  double x = double(_a.m_x) - _b.m_x;
+  double y = double(_a.m_y) - _b.m_y;
+  double z = double(_a.m_z) - _b.m_z;
+  return x*x + y*y + z*z <= double(_epsilon)*_epsilon;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned int weldVertices( std::vector<LODVec3> &io_verts, float _epsilon, std::vector<int> &o_remap )
+{
+  unsigned int nVerts = io_verts.size();
+  o_remap.resize(nVerts);
+  if (nVerts == 0)
+  {
+    return 0;
+  }
+
+  // a table of at least twice as many buckets as vertices keeps the chains short
+  unsigned int nBuckets = 1;
+  while (nBuckets < nVerts*2u && nBuckets < (1u << 31))
+  {
+    nBuckets <<= 1;
+  }
+  const unsigned int mask = nBuckets-1;
+  std::vector<WeldCell> cells(nVerts);
+  std::vector<unsigned int> bucket(nVerts);
+  std::vector<std::atomic<unsigned int> > cursor(nBuckets);
+  parallelFor(0, nBuckets, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      cursor[i].store(0, std::memory_order_relaxed);
+    }
+  });
+  parallelFor(0, nVerts, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      WeldCell &cell = cells[i];
+      cell.m_x = cellOf(io_verts[i].m_x, _epsilon);
+      cell.m_y = cellOf(io_verts[i].m_y, _epsilon);
+      cell.m_z = cellOf(io_verts[i].m_z, _epsilon);
+      bucket[i] = bucketOf(cell.m_x, cell.m_y, cell.m_z, mask);
+      cursor[bucket[i]].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  // group the vertices by bucket with a counting sort, as buildAdjacency does with the corners
+  std::vector<unsigned int> start(nBuckets+1, 0);
+  for (unsigned int i=0; i<nBuckets; ++i)
+  {
+    start[i+1] = start[i] + cursor[i].load(std::memory_order_relaxed);
+    cursor[i].store(start[i], std::memory_order_relaxed);
+  }
+  std::vector<unsigned int> sorted(nVerts);
+  parallelFor(0, nVerts, 65536, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      sorted[cursor[bucket[i]].fetch_add(1, std::memory_order_relaxed)] = i;
+    }
+  });
+
+  // each vertex lists the lower numbered vertices within epsilon of it, counted then filled like the CSR
+  // adjacency lists. Anything within epsilon is in one of the 27 cells around, or only the vertex's own cell for
+  // exact duplicates
+  const int reach = _epsilon == 0.0f ? 0 : 1;
+  auto forEachNear = [&](unsigned int _v, auto _func)
+  {
+    for (int x=-reach; x<=reach; ++x)
+    {
+      for (int y=-reach; y<=reach; ++y)
+      {
+        for (int z=-reach; z<=reach; ++z)
+        {
+          long long cx = cells[_v].m_x+x;
+          long long cy = cells[_v].m_y+y;
+          long long cz = cells[_v].m_z+z;
+          unsigned int b = bucketOf(cx, cy, cz, mask);
+          for (unsigned int i=start[b]; i<start[b+1]; ++i)
+          {
+            unsigned int w = sorted[i];
+            if (w < _v && cells[w].m_x == cx && cells[w].m_y == cy && cells[w].m_z == cz &&
+                isNear(io_verts[_v], io_verts[w], _epsilon))
+            {
+              _func(w);
+            }
+          }
+        }
+      }
+    }
+  };
+  std::vector<unsigned int> nearStart(nVerts+1, 0);
+  parallelFor(0, nVerts, 4096, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int v=_begin; v<_end; ++v)
+    {
+      unsigned int n = 0;
+      forEachNear(v, [&](unsigned int) { ++n; });
+      nearStart[v+1] = n;
+    }
+  });
+  for (unsigned int v=0; v<nVerts; ++v)
+  {
+    nearStart[v+1] += nearStart[v];
+  }
+  std::vector<unsigned int> nearList(nearStart[nVerts]);
+  parallelFor(0, nVerts, 4096, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int v=_begin; v<_end; ++v)
+    {
+      unsigned int *list = nearList.data()+nearStart[v];
+      unsigned int n = 0;
+      forEachNear(v, [&](unsigned int _w) { list[n++] = _w; });
+      // the order within a bucket depends on the threads, sorted the lists don't
+      std::sort(list, list+n);
+    }
+  });
+
+  // going up the ids, a vertex joins the lowest numbered vertex within epsilon of it that was kept. Vertices
+  // that were merged away are skipped rather than followed, so nothing moves further than epsilon. The kept
+  // vertices are numbered in their old order
+  std::vector<char> kept(nVerts, 0);
+  unsigned int nKept = 0;
+  for (unsigned int v=0; v<nVerts; ++v)
+  {
+    int target = -1;
+    for (unsigned int i=nearStart[v]; i<nearStart[v+1]; ++i)
+    {
+      if (kept[nearList[i]])
+      {
+        target = nearList[i];
+        break;
+      }
+    }
+    if (target < 0)
+    {
+      kept[v] = 1;
+      io_verts[nKept] = io_verts[v];
+      o_remap[v] = nKept++;
+    }
+    else
+    {
+      o_remap[v] = o_remap[target];
+    }
+  }
+  io_verts.resize(nKept);
+  return nVerts-nKept;
+}
+//----------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,204 @@
+#include "WorkingMesh.h"
+#include "ParallelFor.h"
+#include "FaceKernels.h"
+#include <algorithm>
+#include <assert.h>
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @file WorkingMesh.cpp
+/// @brief implementation files for WorkingMesh class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief remove every copy of an id from a ring, keeping the order of the rest
+//----------------------------------------------------------------------------------------------------------------------
+static void eraseID( AdjList<int> &io_list, int _id )
+{
+  io_list.erase(std::remove(io_list.begin(), io_list.end(), _id), io_list.end());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @brief get the bytes a list has reserved
+//----------------------------------------------------------------------------------------------------------------------
+template <typename T>
+static unsigned long long listBytes( const std::vector<T> &_list )
+{
+  return _list.capacity()*(unsigned long long)sizeof(T);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::build( const std::vector<LODVec3> &_verts, const std::vector<int> &_faceVert,
+                         const std::vector<unsigned int> &_vertAdjStart, const std::vector<unsigned int> &_vertAdj,
+                         const std::vector<unsigned int> &_faceAdjStart, const std::vector<unsigned int> &_faceAdj )
+{
+  clear();
+  unsigned int nVerts = _verts.size();
+  unsigned int nFaces = _faceVert.size()/3;
+  m_pos = _verts;
+  m_cost.resize(nVerts);
+  m_collapse.resize(nVerts);
+  m_costStale.assign(nVerts, 0);
+  m_mark.assign(nVerts, 0);
+  m_markEpoch = 0;
+  m_vertAdj.resize(nVerts);
+  m_faceAdj.resize(nVerts);
+  m_faceVert = _faceVert;
+  m_faceNormalX.resize(nFaces);
+  m_faceNormalY.resize(nFaces);
+  m_faceNormalZ.resize(nFaces);
+  m_allocatedBytes += listBytes(m_pos) + listBytes(m_cost) + listBytes(m_collapse) + listBytes(m_costStale) +
+                      listBytes(m_mark) + listBytes(m_vertAdj) + listBytes(m_faceAdj) + listBytes(m_faceVert) +
+                      listBytes(m_faceNormalX) + listBytes(m_faceNormalY) + listBytes(m_faceNormalZ);
+
+  // the rings are the base lists laid out the same way, each vertex only fills its own so they are independent
+  m_vertAdjStore.build(_vertAdjStart);
+  m_faceAdjStore.build(_faceAdjStart);
+  parallelFor(0, nVerts, 4096, [&](unsigned int _begin, unsigned int _end)
+  {
+    for (unsigned int i=_begin; i<_end; ++i)
+    {
+      m_vertAdjStore.assign(i, m_vertAdj[i]);
+      std::copy(_vertAdj.data()+_vertAdjStart[i], _vertAdj.data()+_vertAdjStart[i+1], m_vertAdj[i].begin());
+      m_faceAdjStore.assign(i, m_faceAdj[i]);
+      std::copy(_faceAdj.data()+_faceAdjStart[i], _faceAdj.data()+_faceAdjStart[i+1], m_faceAdj[i].begin());
+    }
+  });
+  parallelFor(0, nFaces, 4096, [&](unsigned int _begin, unsigned int _end)
+  {
+    calculateFaceNormalRange(m_pos.data(), m_faceVert.data(), _begin, _end,
+                             m_faceNormalX.data(), m_faceNormalY.data(), m_faceNormalZ.data());
+  });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::clear()
+{
+  // swapped out rather than cleared so the memory goes back straight away
+  std::vector<LODVec3>().swap(m_pos);
+  std::vector<float>().swap(m_cost);
+  std::vector<int>().swap(m_collapse);
+  std::vector<char>().swap(m_costStale);
+  std::vector<unsigned int>().swap(m_mark);
+  std::vector<AdjList<int> >().swap(m_vertAdj);
+  std::vector<AdjList<int> >().swap(m_faceAdj);
+  std::vector<int>().swap(m_faceVert);
+  std::vector<float>().swap(m_faceNormalX);
+  std::vector<float>().swap(m_faceNormalY);
+  std::vector<float>().swap(m_faceNormalZ);
+  m_vertAdjStore.clear();
+  m_faceAdjStore.clear();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+unsigned long long WorkingMesh::getAllocatedBytes() const
+{
+  return m_allocatedBytes + m_vertAdjStore.getAllocatedBytes() + m_faceAdjStore.getAllocatedBytes();
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool WorkingMesh::hasAdjVert( int _v, int _w ) const
+{
+  return (std::find(m_vertAdj[_v].begin(), m_vertAdj[_v].end(), _w) != m_vertAdj[_v].end());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::calculateFaceNormals( const int *_faces, unsigned int _nFaces )
+{
+  ::calculateFaceNormals(m_pos.data(), m_faceVert.data(), _faces, _nFaces,
+                         m_faceNormalX.data(), m_faceNormalY.data(), m_faceNormalZ.data());
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::remIfNonNeighbour( int _v, int _w )
+{
+  if (!hasAdjVert(_v, _w))
+  {
+    return;
+  }
+  const AdjList<int> &faces = m_faceAdj[_v];
+  for (unsigned int i=0; i<faces.size(); ++i)
+  {
+    if (faceHasVert(faces[i], _w))
+    {
+      return;
+    }
+  }
+  eraseID(m_vertAdj[_v], _w);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::removeFace( int _f )
+{
+  const int *fv = &m_faceVert[_f*3];
+  for (unsigned int i=0; i<3; ++i)
+  {
+    eraseID(m_faceAdj[fv[i]], _f);
+  }
+  for (unsigned int i=0; i<3; ++i)
+  {
+    int i2 = (i+1)%3;
+    remIfNonNeighbour(fv[i], fv[i2]);
+    remIfNonNeighbour(fv[i2], fv[i]);
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::removeVertex( int _v )
+{
+  for (unsigned int i=0; i<m_vertAdj[_v].size(); ++i)
+  {
+    eraseID(m_vertAdj[m_vertAdj[_v][i]], _v);
+  }
+  // the slices go back to be reused by the rings that grow
+  m_vertAdjStore.release(m_vertAdj[_v]);
+  m_faceAdjStore.release(m_faceAdj[_v]);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::replaceVertex( int _f, int _u, int _v )
+{
+  int *fv = &m_faceVert[_f*3];
+  assert(fv[0] == _u || fv[1] == _u || fv[2] == _u);
+  assert(fv[0] != _v && fv[1] != _v && fv[2] != _v);
+  for (unsigned int i=0; i<3; ++i)
+  {
+    if (fv[i] == _u)
+    {
+      fv[i] = _v;
+      break;
+    }
+  }
+  eraseID(m_faceAdj[_u], _f);
+  if (std::find(m_faceAdj[_v].begin(), m_faceAdj[_v].end(), _f) == m_faceAdj[_v].end())
+  {
+    m_faceAdj[_v].push_back(_f);
+  }
+  for (unsigned int i=0; i<3; ++i)
+  {
+    remIfNonNeighbour(_u, fv[i]);
+    remIfNonNeighbour(fv[i], _u);
+  }
+  // every vertex of the face now needs the other two, _v is new to the ones that were around _u
+  for (unsigned int i=0; i<3; ++i)
+  {
+    for (unsigned int j=0; j<3; ++j)
+    {
+      if (i != j && !hasAdjVert(fv[i], fv[j]))
+      {
+        m_vertAdj[fv[i]].push_back(fv[j]);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void WorkingMesh::beginMarks()
+{
+  if (++m_markEpoch == 0)
+  {
+    // the epochs have wrapped around, so old marks could match again
+    std::fill(m_mark.begin(), m_mark.end(), 0);
+    m_markEpoch = 1;
+  }
+}
+//----------------------------------------------------------------------------------------------------------------------
@@ -41,7 +41,9 @@ public :
 
   void setModelLOD(const std::string _fname);
 
-  void createLOD(unsigned int _nFaces);
+  /// @brief add a LOD made off the GL thread (see LODWorker), its VAO is created here with the context current
+  /// @param[in] _lod the LOD, the window takes ownership of it
+  void addLOD(ModelLODTri *_lod);
 
   std::vector<ModelLODTri *> getLODs(){return m_lods;}
 
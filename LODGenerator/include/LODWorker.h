@@ -0,0 +1,93 @@
+#ifndef LODWORKER_H_
+#define LODWORKER_H_
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODWorker.h
+/// @brief runs ModelLODTri::createLOD off the UI thread
+//----------------------------------------------------------------------------------------------------------------------
+
+#include <atomic>
+
+#include <QThread>
+
+#include "ModelLODTri.h"
+
+//----------------------------------------------------------------------------------------------------------------------
+/// @class LODWorker "include/LODWorker.h"
+/// @brief a thread that makes one LOD of a model so the UI keeps drawing and responding while a big mesh is
+///   decimated. Progress is sent back with the progress signal and the LOD is picked up with takeLOD once the
+///   thread has finished. Nothing here touches GL, the LOD's VAO is made afterwards on the GL thread
+/// @author Jonathan Flynn
+/// @version 1.0
+/// @date 17/10/26 moved LOD creation off the UI thread
+//----------------------------------------------------------------------------------------------------------------------
+class LODWorker : public QThread
+{
+Q_OBJECT
+
+public:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief constructor, the LOD isn't made until the thread is started
+  /// @param[in] _model the model to make a LOD of, it mustn't be changed or deleted until the thread finishes
+  /// @param[in] _nFaces the number of faces the LOD will have
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @param[in] _parent the owner of the worker
+  //----------------------------------------------------------------------------------------------------------------------
+  LODWorker( ModelLODTri *_model, unsigned int _nFaces, LODCostMetric _metric, QObject *_parent=0 );
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief destructor, deletes the LOD if it was never taken
+  //----------------------------------------------------------------------------------------------------------------------
+  ~LODWorker();
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief ask the decimation to stop, it does at its next progress report and no LOD is made. Can be called
+  ///   from any thread
+  //----------------------------------------------------------------------------------------------------------------------
+  void cancel() {m_cancelled = true;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief get if cancel was called
+  //----------------------------------------------------------------------------------------------------------------------
+  bool getCancelled() const {return m_cancelled;}
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief take the finished LOD, only call once the thread has finished
+  /// @returns the LOD with no VAO yet, the caller owns it. NULL if it was cancelled or already taken
+  //----------------------------------------------------------------------------------------------------------------------
+  ModelLODTri* takeLOD();
+
+signals:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief sent from the worker thread every few thousand faces while the collapse record is built
+  /// @param[in] _nRemoved the faces removed so far
+  /// @param[in] _nTarget the faces the whole decimation removes
+  //----------------------------------------------------------------------------------------------------------------------
+  void progress( int _nRemoved, int _nTarget );
+
+protected:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief make the LOD, runs on the worker thread
+  //----------------------------------------------------------------------------------------------------------------------
+  void run();
+
+private:
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the model the LOD is made from
+  //----------------------------------------------------------------------------------------------------------------------
+  ModelLODTri *m_model;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the number of faces wanted
+  //----------------------------------------------------------------------------------------------------------------------
+  unsigned int m_nFaces;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the metric to decimate with
+  //----------------------------------------------------------------------------------------------------------------------
+  LODCostMetric m_metric;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief set by cancel, read by the progress callback on the worker thread
+  //----------------------------------------------------------------------------------------------------------------------
+  std::atomic<bool> m_cancelled;
+  //----------------------------------------------------------------------------------------------------------------------
+  /// @brief the finished LOD until it is taken
+  //----------------------------------------------------------------------------------------------------------------------
+  ModelLODTri *m_lod;
+};
+
+#endif
+//----------------------------------------------------------------------------------------------------------------------
@@ -3,6 +3,7 @@
 
 #include <QMainWindow>
 #include "GLWindow.h"
+#include "LODWorker.h"
 
 namespace Ui {
 class MainWindow;
@@ -29,11 +30,25 @@ private slots:
 
   void on_exportLODB_clicked();
 
+  void on_cancelLODB_clicked();
+
+  /// @brief show the progress sent by m_worker
+  void lodProgress(int _nRemoved, int _nTarget);
+
+  /// @brief pick up the LOD m_worker made, if it wasn't cancelled, and add it to the list
+  void lodFinished();
+
 private:
+  /// @brief switch the controls between making a LOD and waiting for one
+  /// @param[in] _creating true while m_worker is running
+  void setCreatingLOD(bool _creating);
+
   Ui::MainWindow *m_ui;
   /// @brief our openGL widget
 
   GLWindow *m_gl;
+  /// @brief the thread making a LOD, NULL when none is being made
+  LODWorker *m_worker;
 };
 
 #endif // MAINWINDOW_H
@@ -1,22 +1,14 @@
 #ifndef MODELLODTRI_H_
 #define MODELLODTRI_H_
 //----------------------------------------------------------------------------------------------------------------------
-/// @file ModelLOD.h
-/// @brief obj loader and LOD creator. Inherits from AbstractMesh
+/// @file ModelLODTri.h
+/// @brief GUI mesh for a LODMesh. Inherits from AbstractMesh so it can be drawn with NGL
 //----------------------------------------------------------------------------------------------------------------------
 // must include types.h first for Real and GLEW if required
 #include <ngl/Types.h>
 
 #include <vector>
-#include <iostream>
-#include <fstream>
 #include <string>
-#include <memory>
-#include <vector>
-#include <cmath>
-#include <stdlib.h>
-#include <list>
-#include <utility>
 
 #include <ngl/Texture.h>
 #include <ngl/Vec4.h>
@@ -24,25 +16,18 @@
 #include <ngl/BBox.h>
 #include <ngl/RibExport.h>
 
-#include "TriangleV.h"
-
-
-//----------------------------------------------------------------------------------------------------------------------
-/// @brief compare two Vertex pointers collapse cost and return the higher one
-/// @returns bool of the higher value
-//----------------------------------------------------------------------------------------------------------------------
-bool compareVertexCost(Vertex*& a, Vertex*& b);
+#include "LODMesh.h"
 
 
 //----------------------------------------------------------------------------------------------------------------------
 /// @class ModelLODTri "include/ModelLODTri.h"
-/// @brief used to store vertex information from an imported model and used as
-///		as a means of creating an LOD model.
+/// @brief used to draw an imported model or one of its LODs. All the loading and LOD creation is done by the
+///   LODMesh it wraps, this class only copies the result into the AbstractMesh lists for NGL
 /// modified version of the Obj class from the NGL library
 /// @author Jonathan Flynn
-/// @version 0.1
+/// @version 0.2
 /// @date 02/03/15 imported code from Obj.h
-/// @todo add functionality to store adjacent triangles/vertices and use classes
+/// @date 17/10/26 loading and decimation moved into the core LODMesh class
 //----------------------------------------------------------------------------------------------------------------------
 class ModelLODTri : public ngl::AbstractMesh
 {
@@ -53,10 +38,6 @@ public :
   //----------------------------------------------------------------------------------------------------------------------
   virtual ~ModelLODTri();
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief default constructor
-  //----------------------------------------------------------------------------------------------------------------------
-  ModelLODTri() : AbstractMesh(){;}
-  //----------------------------------------------------------------------------------------------------------------------
   /// @brief  constructor to load an objfile as a parameter
   /// @param[in]  &_fname the name of the obj file to load
   //----------------------------------------------------------------------------------------------------------------------
@@ -68,125 +49,59 @@ public :
   //----------------------------------------------------------------------------------------------------------------------
   ModelLODTri( const std::string& _fname,  const std::string& _texName );
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief copy constructor for LOD creation
-  //----------------------------------------------------------------------------------------------------------------------
-  ModelLODTri(ModelLODTri &_m );
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief  Method to load the file in
-  /// @param[in]  _fname the name of the obj file to load
-  /// @param[in] _calcBB if we only want to load data and not use GL then set this to false
+  /// @brief constructor for an already made mesh such as a LOD. Doesn't create the VAO so it can be called
+  ///   without a GL context, call createVAO before drawing
+  /// @param[in] _mesh the mesh to draw, ModelLODTri takes ownership of it
   //----------------------------------------------------------------------------------------------------------------------
-  bool load( const std::string& _fname, bool _calcBB=true ) noexcept;
+  ModelLODTri( LODMesh *_mesh );
   //----------------------------------------------------------------------------------------------------------------------
   /// @brief  method to save the obj
   /// @param[in] _fname the name of the file to save
   //----------------------------------------------------------------------------------------------------------------------
   void save( const std::string& _fname  ) const;
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief  method to create a LOD for the current mesh
+  /// @brief  method to create a LOD for the current mesh, see LODMesh::createLOD
   /// @param[in] _nFaces the number of faces the LOD mesh will have
-  /// @returns ModelLODTri* of the reduced mesh LOD with _nFaces
-  //----------------------------------------------------------------------------------------------------------------------
-  ModelLODTri* createLOD(const unsigned int _nFaces );
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief stores the Vertex information in my Vertex class and stores the necessary data for creating the last LOD created
-  //----------------------------------------------------------------------------------------------------------------------
-  std::vector<Vertex *> m_lodVertexOut;
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief stores the face/triangle information in my Triangle class and stores the necessary data for the last LOD created
-  //----------------------------------------------------------------------------------------------------------------------
-  std::vector<Triangle *> m_lodTriangleOut;
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief stores the Vertex class info in descending order from collapse cost
-  //----------------------------------------------------------------------------------------------------------------------
-  std::list<Vertex *> m_lodVertexCollapseCost;
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief copy the Triangle information and return the lists
-  /// @param[in] _vtxData has to be the exact structure of data from m_lodTriangle or m_lodTriangleOut
-  /// @returns std::vector<Triangle *> of all the triangle data cloned
-  //----------------------------------------------------------------------------------------------------------------------
-  vtxTriData copyVtxTriData(std::vector<Vertex *> _vtxData ,std::vector<Triangle *> _triData);
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief copy Vertex and Triangle information to Out variables
-  //----------------------------------------------------------------------------------------------------------------------
-  void copyVtxTriNormTexDataToOut();
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief clear Vertex and Triangle information from Out variables
-  //----------------------------------------------------------------------------------------------------------------------
-  void clearVtxTriDataOut();
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @returns ModelLODTri* of the reduced mesh LOD with _nFaces, its VAO still needs creating. NULL if the
+  ///   LODMesh progress callback cancelled it
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief store Vertex pointers in descending collapse costs in an ordered list of
+  ModelLODTri* createLOD(const unsigned int _nFaces, LODCostMetric _metric=COST_MELAX );
   //----------------------------------------------------------------------------------------------------------------------
-  void storeCollapseCostList();
+  /// @brief  method to create a LOD for the current mesh with a target vertex count
+  /// @param[in] _nVerts the number of vertices the LOD mesh will be reduced to
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @returns ModelLODTri* of the reduced mesh LOD, its VAO still needs creating. NULL if it was cancelled
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief clear collapse cost ordered list
+  ModelLODTri* createLODByVertices(const unsigned int _nVerts, LODCostMetric _metric=COST_MELAX );
   //----------------------------------------------------------------------------------------------------------------------
-  void clearCollapseCostList();
+  /// @brief  create a chain of LODs in one pass, see LODMesh::createLODChain
+  /// @param[in] _nFaces the number of faces of each LOD
+  /// @param[in] _metric the edge collapse cost to decimate with
+  /// @returns the LODs in the same order as _nFaces, their VAOs still need creating. Empty if it was cancelled
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief update collapse cost ordered list
-  //----------------------------------------------------------------------------------------------------------------------
-  void updateCollapseCostList();
+  std::vector<ModelLODTri*> createLODChain( const std::vector<unsigned int> &_nFaces,
+                                            LODCostMetric _metric=COST_MELAX );
   //----------------------------------------------------------------------------------------------------------------------
   /// @brief get if loaded or not
   /// returns bool of m_loaded
   //----------------------------------------------------------------------------------------------------------------------
   bool getLoaded() {return m_loaded;}
-
-protected :
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief parser function to parse the vertex used by boost::spirit parser
-  /// @param[in] _begin the start of the string to parse
-  //----------------------------------------------------------------------------------------------------------------------
-  void parseVertex( const char *_begin );
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief parser function to parse the Norma used by boost::spirit parser
-  /// @param[in] _begin the start of the string to parse
-  //----------------------------------------------------------------------------------------------------------------------
-  void parseNormal( const char *_begin  );
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief parser function to parse the text cord used by boost::spirit parser
-  /// @param[in] _begin the start of the string to parse
-  //----------------------------------------------------------------------------------------------------------------------
-  void parseTextureCoordinate( const char * _begin );
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief parser function to parse the Face data used by boost::spirit parser
-  /// @param[in] _begin the start of the string to parse
-  //----------------------------------------------------------------------------------------------------------------------
-  void parseFace( const char * _begin );
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief  calculate the cost of an edge collapse from two vertices
-  /// @param[in] _u vertex pointer, from this vertex collapse cost onto _v
-  /// @param[in] _v vertex pointer, collapse cost onto this vertex from _u
-  /// @returns float of the collapse cost from _u to _v
+  /// @brief get the core mesh
+  /// @returns the LODMesh this model draws
   //----------------------------------------------------------------------------------------------------------------------
-  float calculateEColCost( Vertex* _u, Vertex* _v);
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief  calculate the cost of all adjacent vertex collapses from selected vertex
-  /// @param[in] _v vertex pointer from which all collapse costs will be calculated
-  //----------------------------------------------------------------------------------------------------------------------
-  void calculateEColCostAtVtx( Vertex* _v);
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief  calculate all edge collapse costs
-  //----------------------------------------------------------------------------------------------------------------------
-  void calculateAllEColCosts();
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief  collapse the edge between two vertices. Use vertices from m_lodVertexOut!
-  /// @param[in] _u vertex pointer, from this vertex collapse onto _v
-  /// @param[in] _v vertex pointer, collapse onto this vertex from _u
-  //----------------------------------------------------------------------------------------------------------------------
-  void collapseEdge( Vertex* _u, Vertex* _v );
-  //----------------------------------------------------------------------------------------------------------------------
-  /// @brief stores the Vertex information in my Vertex class
-  //----------------------------------------------------------------------------------------------------------------------
-  std::vector<Vertex *> m_lodVertex;
+  LODMesh* getLODMesh() {return m_mesh;}
+
+protected :
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief stores the face/triangle information in my Triangle class
+  /// @brief copy the vertex, normal, texture coord and face lists out of m_mesh into the AbstractMesh ones
   //----------------------------------------------------------------------------------------------------------------------
-  std::vector<Triangle *> m_lodTriangle;
+  void copyMeshData();
   //----------------------------------------------------------------------------------------------------------------------
-  /// @brief stores current number of deleted faces for current lod creation
+  /// @brief the core mesh that does the loading and LOD creation
   //----------------------------------------------------------------------------------------------------------------------
-  unsigned int m_nDeletedFaces;
+  LODMesh *m_mesh;
 };
 
 
@@ -194,4 +109,3 @@ protected :
 
 #endif
 //----------------------------------------------------------------------------------------------------------------------
-
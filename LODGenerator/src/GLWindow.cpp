@@ -407,9 +407,12 @@ void GLWindow::setModelLOD(const std::string _fname)
   updateGL();
 }
 
-void GLWindow::createLOD(unsigned int _nFaces)
+void GLWindow::addLOD(ModelLODTri *_lod)
 {
-  m_lods.push_back(m_modelLOD->createLOD(_nFaces));
+  // the LOD is made without touching GL so the VAO is created here where the context is current
+  makeCurrent();
+  _lod->createVAO();
+  m_lods.push_back(_lod);
 }
 
 void GLWindow::exportAllLOD()
@@ -0,0 +1,57 @@
+#include "LODWorker.h"
+//----------------------------------------------------------------------------------------------------------------------
+/// @file LODWorker.cpp
+/// @brief implementation files for LODWorker class
+//----------------------------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------------------------
+LODWorker::LODWorker( ModelLODTri *_model, unsigned int _nFaces, LODCostMetric _metric, QObject *_parent ) :
+  QThread(_parent),
+  m_model(_model),
+  m_nFaces(_nFaces),
+  m_metric(_metric),
+  m_cancelled(false),
+  m_lod(NULL)
+{
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+LODWorker::~LODWorker()
+{
+  // a worker deleted while it is still going has to stop before the model and LOD go
+  cancel();
+  wait();
+  delete m_lod;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+ModelLODTri *LODWorker::takeLOD()
+{
+  ModelLODTri *lod = m_lod;
+  m_lod = NULL;
+  return lod;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void LODWorker::run()
+{
+  // the callback runs on this thread, the queued signal carries the progress over to the UI thread
+  LODMesh *mesh = m_model->getLODMesh();
+  mesh->setProgressCallback([this](unsigned int _nRemoved, unsigned int _nTarget)
+  {
+    emit progress(int(_nRemoved), int(_nTarget));
+    return !m_cancelled;
+  });
+  if (!m_cancelled)
+  {
+    m_lod = m_model->createLOD(m_nFaces, m_metric);
+  }
+  mesh->setProgressCallback(LODProgressCallback());
+
+  // a cancel that came after the last progress report still throws the LOD away, as asked
+  if (m_cancelled)
+  {
+    delete m_lod;
+    m_lod = NULL;
+  }
+}
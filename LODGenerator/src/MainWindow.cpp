@@ -10,7 +10,8 @@
 
 MainWindow::MainWindow(QWidget *parent) :
   QMainWindow(parent),
-  m_ui(new Ui::MainWindow)
+  m_ui(new Ui::MainWindow),
+  m_worker(NULL)
 {
   m_ui->setupUi(this);
 
@@ -40,6 +41,8 @@ MainWindow::MainWindow(QWidget *parent) :
 
 MainWindow::~MainWindow()
 {
+  // stops and waits for a LOD that is still being made
+  delete m_worker;
   delete m_ui;
 }
 
@@ -126,7 +129,50 @@ void MainWindow::on_deleteLODB_clicked()
 
 void MainWindow::on_createLODB_clicked()
 {
-  m_gl->createLOD(m_ui->nFaces->value());
+  if (m_worker != NULL || m_gl->getModelLODTri() == NULL)
+  {
+    return;
+  }
+  // the decimation runs on its own thread so the window keeps drawing, lodFinished picks the LOD up after.
+  // The combo box items are in the same order as LODCostMetric
+  m_worker = new LODWorker(m_gl->getModelLODTri(), m_ui->nFaces->value(),
+                           LODCostMetric(m_ui->costMetric->currentIndex()), this);
+  connect(m_worker,SIGNAL(progress(int,int)),this,SLOT(lodProgress(int,int)));
+  connect(m_worker,SIGNAL(finished()),this,SLOT(lodFinished()));
+  setCreatingLOD(true);
+  m_worker->start();
+}
+
+void MainWindow::on_cancelLODB_clicked()
+{
+  if (m_worker != NULL)
+  {
+    // the worker stops at its next progress report, lodFinished then tidies up as usual
+    m_worker->cancel();
+    m_ui->cancelLODB->setEnabled(false);
+  }
+}
+
+void MainWindow::lodProgress(int _nRemoved, int _nTarget)
+{
+  m_ui->lodProgress->setMaximum(_nTarget);
+  m_ui->lodProgress->setValue(_nRemoved);
+}
+
+void MainWindow::lodFinished()
+{
+  ModelLODTri *lod = m_worker->takeLOD();
+  m_worker->deleteLater();
+  m_worker = NULL;
+  setCreatingLOD(false);
+  if (lod == NULL)
+  {
+    m_ui->statusbar->showMessage(tr("LOD cancelled"), 3000);
+    return;
+  }
+
+  // only the VAO upload is left for the GL thread
+  m_gl->addLOD(lod);
   QString id = SSTR(m_gl->getLODs().size()).c_str();
   m_gl->updateAllLODs();
   m_ui->m_lods->addItem(id);
@@ -134,6 +180,19 @@ void MainWindow::on_createLODB_clicked()
   m_gl->extUpdateGL();
 }
 
+void MainWindow::setCreatingLOD(bool _creating)
+{
+  // the base mesh can't be swapped out from under the worker
+  m_ui->loadB->setEnabled(!_creating);
+  m_ui->createLODB->setEnabled(!_creating);
+  m_ui->nFaces->setEnabled(!_creating);
+  m_ui->costMetric->setEnabled(!_creating);
+  m_ui->cancelLODB->setEnabled(_creating);
+  m_ui->lodProgress->setEnabled(_creating);
+  m_ui->lodProgress->setMaximum(100);
+  m_ui->lodProgress->setValue(0);
+}
+
 void MainWindow::on_exportAllB_clicked()
 {
     m_gl->exportAllLOD();